@@ -1,5 +1,6 @@
 #include "Mel.h"
 #include "Mel_version.h"  // 生成的版本头文件
+#include "widgets/PixelBudget.h"
 
 namespace Mel {
 
@@ -31,4 +32,16 @@ QString MelLib::getVersionString() {
     return MEL_VERSION_STRING;
 }
 
+void MelLib::setPixelMemoryBudget(const qint64 bytes) {
+    PixelBudget::instance().setBudget(bytes);
+}
+
+qint64 MelLib::getPixelMemoryBudget() {
+    return PixelBudget::instance().getBudget();
+}
+
+qint64 MelLib::getPixelMemoryUsage() {
+    return PixelBudget::instance().getUsage();
+}
+
 } // namespace Mel
@@ -25,6 +25,22 @@ public:
     static int getVersionPatch();
 
     static QString getVersionString();
+
+    // 像素内存预算
+
+    /**
+     * @brief 设置所有背景控件持有的像素缓冲区的字节预算（默认 0，不限制）
+     *
+     * 超出时最久未绘制的控件先释放可重新生成的缓冲区，详见 PixelBudget
+     */
+    static void setPixelMemoryBudget(qint64 bytes);
+
+    static qint64 getPixelMemoryBudget();
+
+    /**
+     * @brief 获取所有背景控件当前持有的像素缓冲区字节数
+     */
+    static qint64 getPixelMemoryUsage();
 };
 
 } // namespace Mel
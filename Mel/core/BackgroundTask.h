@@ -0,0 +1,48 @@
+/**
+ * @file BackgroundTask.h
+ * @brief 后台任务工具 - 在线程池中执行任务，并将结果投递回主线程
+ */
+
+#ifndef MEL_BACKGROUNDTASK_H
+#define MEL_BACKGROUNDTASK_H
+
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
+#include <utility>
+
+namespace Mel {
+
+/**
+ * @brief 在线程池中执行任务，完成后在主线程中调用回调
+ *
+ * 接收者在任务执行期间被销毁时，回调不再执行（结果直接丢弃）
+ *
+ * @param pool 线程池
+ * @param receiver 接收者（必须位于主线程）
+ * @param work 后台任务，返回值作为回调参数（在工作线程中执行）
+ * @param done 完成回调（在主线程中执行）
+ */
+template<typename Work, typename Done>
+void runInBackground(QThreadPool *pool, QObject *receiver, Work work, Done done) {
+    // 接收者可能在任务执行期间被销毁，用 QPointer 在主线程中判断
+    QPointer<QObject> guard(receiver);
+
+    pool->start([guard, work = std::move(work), done = std::move(done)]() mutable {
+        auto result = work();
+
+        // 结果投递回主线程（qApp 位于主线程且生命周期覆盖整个程序）
+        QMetaObject::invokeMethod(
+                QCoreApplication::instance(),
+                [guard, done = std::move(done), result = std::move(result)]() mutable {
+                    if (guard) {
+                        done(std::move(result));
+                    }
+                },
+                Qt::QueuedConnection);
+    });
+}
+
+} // namespace Mel
+
+#endif // MEL_BACKGROUNDTASK_H
@@ -0,0 +1,12 @@
+/**
+ * @file Logging.cpp
+ * @brief 日志分类实现
+ */
+
+#include "Logging.h"
+
+namespace Mel {
+
+Q_LOGGING_CATEGORY(lcMel, "mel", QtWarningMsg)
+
+} // namespace Mel
@@ -0,0 +1,23 @@
+/**
+ * @file Logging.h
+ * @brief 日志分类 - Mel 的调试输出默认关闭，通过 QT_LOGGING_RULES="mel.debug=true" 开启
+ */
+
+#ifndef MEL_LOGGING_H
+#define MEL_LOGGING_H
+
+#include "Mel_export.h"
+#include <QLoggingCategory>
+
+namespace Mel {
+
+/**
+ * @brief Mel 的日志分类（"mel"），默认只输出警告及以上级别
+ *
+ * 热路径中的 qCDebug 在分类关闭时只做一次判断，不会构造输出流
+ */
+MEL_EXPORT const QLoggingCategory &lcMel();
+
+} // namespace Mel
+
+#endif // MEL_LOGGING_H
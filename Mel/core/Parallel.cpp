@@ -0,0 +1,42 @@
+/**
+ * @file Parallel.cpp
+ * @brief 并行计算工具实现
+ */
+
+#include "Parallel.h"
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+namespace Mel {
+
+QThreadPool *computePool() {
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool();
+        p->setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        return p;
+    }();
+    return pool;
+}
+
+void parallelFor(const int count, const int threadCount, const int minPerThread, const std::function<void(int, int)> &body) {
+    const int chunks = qBound(1, threadCount, qMax(1, count / qMax(1, minPerThread)));
+    if (chunks == 1) {
+        body(0, count);
+        return;
+    }
+
+    QSemaphore finished;
+    for (int i = 1; i < chunks; ++i) {
+        const int begin = static_cast<int>(static_cast<qint64>(count) * i / chunks);
+        const int end   = static_cast<int>(static_cast<qint64>(count) * (i + 1) / chunks);
+        computePool()->start([&body, &finished, begin, end]() {
+            body(begin, end);
+            finished.release();
+        });
+    }
+    body(0, static_cast<int>(count / chunks));
+    finished.acquire(chunks - 1);
+}
+
+} // namespace Mel
@@ -0,0 +1,33 @@
+/**
+ * @file Parallel.h
+ * @brief 并行计算工具 - 把逐行的像素处理拆分到计算线程池
+ */
+
+#ifndef MEL_PARALLEL_H
+#define MEL_PARALLEL_H
+
+#include <functional>
+
+class QThreadPool;
+
+namespace Mel {
+
+/**
+ * @brief 计算线程池（线程数等于 CPU 核数）
+ *
+ * 与解码线程池（ImageLoader::threadPool）分开，在解码线程中等待计算完成时不会死锁
+ */
+QThreadPool *computePool();
+
+/**
+ * @brief 把 [0, count) 拆分到多个线程执行，调用线程也处理其中一段，全部完成后返回
+ * @param count 总数（行数或列数）
+ * @param threadCount 最多使用的线程数
+ * @param minPerThread 每个线程至少处理的数量（数量太少时拆分的开销大于收益）
+ * @param body 处理 [begin, end) 的函数
+ */
+void parallelFor(int count, int threadCount, int minPerThread, const std::function<void(int, int)> &body);
+
+} // namespace Mel
+
+#endif // MEL_PARALLEL_H
@@ -0,0 +1,146 @@
+/**
+ * @file ResourceBundle.cpp
+ * @brief 外部资源包实现
+ */
+
+#include "ResourceBundle.h"
+#include "Logging.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QResource>
+#include <QStringList>
+
+#ifndef MEL_WALLPAPER_BUNDLE
+#define MEL_WALLPAPER_BUNDLE "Mel_wallpapers.rcc"
+#endif
+
+namespace Mel {
+
+namespace {
+
+/**
+ * @brief 内置资源的路径前缀
+ */
+const QLatin1String kResourcePrefix(":/Mel/");
+
+struct BundleState {
+    QMutex      mutex;
+    QStringList searchPaths; // addSearchPath 添加的目录
+    QString     bundlePath;  // 已注册的资源包路径
+    bool        attempted = false;
+    bool        loaded    = false;
+};
+
+BundleState &state() {
+    static BundleState instance;
+    return instance;
+}
+
+/**
+ * @brief 按查找顺序列出候选的资源包路径
+ */
+QStringList candidatePaths(const QStringList &searchPaths) {
+    const QString name = QStringLiteral(MEL_WALLPAPER_BUNDLE);
+
+    QStringList candidates;
+    const QString fromEnvironment = qEnvironmentVariable("MEL_WALLPAPER_BUNDLE");
+    if (!fromEnvironment.isEmpty()) {
+        candidates.append(fromEnvironment);
+    }
+    for (const QString &directory : searchPaths) {
+        candidates.append(QDir(directory).filePath(name));
+    }
+    if (QCoreApplication::instance()) {
+        const QDir applicationDir(QCoreApplication::applicationDirPath());
+        candidates.append(applicationDir.filePath(name));
+        candidates.append(applicationDir.filePath(QStringLiteral("../share/Mel/") + name));
+    }
+    return candidates;
+}
+
+} // namespace
+
+bool ResourceBundle::isExternal() {
+#ifdef MEL_EXTERNAL_WALLPAPERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ResourceBundle::ensureLoaded() {
+    if (!isExternal()) {
+        return true;
+    }
+
+    BundleState &s = state();
+    QMutexLocker locker(&s.mutex);
+    if (s.attempted) {
+        return s.loaded;
+    }
+    s.attempted = true;
+
+    for (const QString &candidate : candidatePaths(s.searchPaths)) {
+        if (!QFileInfo::exists(candidate)) {
+            continue;
+        }
+
+        // Qt 会尝试内存映射资源包文件，失败时才整体读入内存
+        if (QResource::registerResource(candidate)) {
+            s.bundlePath = QFileInfo(candidate).absoluteFilePath();
+            s.loaded     = true;
+            qCDebug(lcMel) << "ResourceBundle: 已注册壁纸资源包:" << s.bundlePath;
+            return true;
+        }
+        qCWarning(lcMel) << "ResourceBundle: 无法注册壁纸资源包:" << candidate;
+    }
+
+    qCWarning(lcMel) << "ResourceBundle: 未找到壁纸资源包" << MEL_WALLPAPER_BUNDLE << "，内置壁纸不可用";
+    return false;
+}
+
+void ResourceBundle::ensureLoadedFor(const QString &path) {
+    if (isExternal() && path.startsWith(kResourcePrefix)) {
+        ensureLoaded();
+    }
+}
+
+bool ResourceBundle::isLoaded() {
+    if (!isExternal()) {
+        return true;
+    }
+
+    BundleState &s = state();
+    QMutexLocker locker(&s.mutex);
+    return s.loaded;
+}
+
+QString ResourceBundle::getBundlePath() {
+    BundleState &s = state();
+    QMutexLocker locker(&s.mutex);
+    return s.bundlePath;
+}
+
+void ResourceBundle::addSearchPath(const QString &directory) {
+    BundleState &s = state();
+    QMutexLocker locker(&s.mutex);
+    if (!s.searchPaths.contains(directory)) {
+        s.searchPaths.append(directory);
+    }
+}
+
+void ResourceBundle::unload() {
+    BundleState &s = state();
+    QMutexLocker locker(&s.mutex);
+    if (s.loaded) {
+        QResource::unregisterResource(s.bundlePath);
+        qCDebug(lcMel) << "ResourceBundle: 已注销壁纸资源包:" << s.bundlePath;
+    }
+    s.bundlePath.clear();
+    s.loaded    = false;
+    s.attempted = false;
+}
+
+} // namespace Mel
@@ -0,0 +1,71 @@
+/**
+ * @file ResourceBundle.h
+ * @brief 外部资源包 - 按需注册独立编译的内置壁纸资源包（.rcc）
+ */
+
+#ifndef MEL_RESOURCEBUNDLE_H
+#define MEL_RESOURCEBUNDLE_H
+
+#include "Mel_export.h"
+#include <QString>
+
+namespace Mel {
+
+/**
+ * @brief 内置壁纸资源包
+ *
+ * 使用 MEL_EXTERNAL_WALLPAPERS 选项构建时，内置壁纸不再编译进 Mel 库，而是生成独立的二进制资源包
+ * Mel_wallpapers.rcc。第一次访问 :/Mel/ 下的资源时（ImageLoader 会自动调用）通过
+ * QResource::registerResource 注册，Qt 以内存映射方式打开资源包，只有实际读取的壁纸才会被换入内存；
+ * 原有的 :/Mel/res/wallpaper/... 路径保持不变。
+ *
+ * 查找顺序：环境变量 MEL_WALLPAPER_BUNDLE 指定的文件、addSearchPath 添加的目录、
+ * 可执行文件所在目录、可执行文件所在目录的 ../share/Mel。
+ * 未使用该选项构建时壁纸已编译进库，所有方法均视为已加载
+ */
+class MEL_EXPORT ResourceBundle {
+public:
+    /**
+     * @brief 内置壁纸是否以外部资源包的形式提供
+     */
+    static bool isExternal();
+
+    /**
+     * @brief 确保内置壁纸可以访问（外部资源包只在第一次调用时查找并注册，可在任意线程调用）
+     * @return 是否可以访问
+     */
+    static bool ensureLoaded();
+
+    /**
+     * @brief 路径位于内置资源（:/Mel/）下时确保资源包已注册
+     * @param path 即将访问的路径
+     */
+    static void ensureLoadedFor(const QString &path);
+
+    /**
+     * @brief 外部资源包是否已注册
+     */
+    static bool isLoaded();
+
+    /**
+     * @brief 获取已注册的资源包路径（未注册或未使用外部资源包时为空）
+     */
+    static QString getBundlePath();
+
+    /**
+     * @brief 添加资源包的查找目录（需在第一次访问内置壁纸之前调用）
+     * @param directory 目录
+     */
+    static void addSearchPath(const QString &directory);
+
+    /**
+     * @brief 注销外部资源包并解除内存映射（之后再次访问时会重新注册）
+     *
+     * 调用前需确保不再有从资源包中打开的文件
+     */
+    static void unload();
+};
+
+} // namespace Mel
+
+#endif // MEL_RESOURCEBUNDLE_H
@@ -0,0 +1,25 @@
+/**
+ * @file Simd.h
+ * @brief SIMD 编译选项 - x86 平台上按函数启用 SSE2 / AVX2 指令集
+ *
+ * 内核函数用 MEL_TARGET_SSE2 / MEL_TARGET_AVX2 标记，整个库仍按基础指令集编译，
+ * 运行时根据 Resampler::detectSimdLevel 的结果选择内核
+ */
+
+#ifndef MEL_SIMD_H
+#define MEL_SIMD_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define MEL_SIMD_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define MEL_TARGET_SSE2
+        #define MEL_TARGET_AVX2
+    #else
+        #define MEL_TARGET_SSE2 __attribute__((target("sse2")))
+        #define MEL_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+#endif // MEL_SIMD_H
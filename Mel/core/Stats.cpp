@@ -0,0 +1,300 @@
+/**
+ * @file Stats.cpp
+ * @brief 运行时性能统计实现
+ */
+
+#include "Stats.h"
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QTimer>
+#include <QtMath>
+#include <algorithm>
+
+namespace Mel {
+
+namespace {
+
+std::atomic<bool> g_enabled{true};
+
+// 当前线程的统计归属
+thread_local std::shared_ptr<StatsBlock> t_current;
+
+const char *const kCounterNames[Counter_Count] = {"decodes", "scales", "paints", "transitionFrames", "transitionDropped", "budgetEvictions"};
+
+const char *const kGaugeNames[Gauge_Count] = {"pixelBytes"};
+
+const char *const kHistogramNames[Histogram_Count] = {"decodeTime", "scaleTime", "paintTime", "blurTime"};
+
+/**
+ * @brief 耗时所在的桶
+ */
+int bucketFor(const qint64 nsecs) {
+    const quint64 usecs = nsecs > 0 ? static_cast<quint64>(nsecs) / 1000 : 0;
+    if (usecs == 0) {
+        return 0;
+    }
+    const int bits = 64 - qCountLeadingZeroBits(usecs);
+    return qMin(bits, HistogramSnapshot::BucketCount - 1);
+}
+
+/**
+ * @brief 原子地更新最大值
+ */
+void updateMax(std::atomic<qint64> &target, const qint64 value) {
+    qint64 current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+// ========== HistogramSnapshot ==========
+
+double HistogramSnapshot::meanMs() const {
+    return count > 0 ? static_cast<double>(totalNs) / 1e6 / static_cast<double>(count) : 0.0;
+}
+
+double HistogramSnapshot::percentileMs(const double percentile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    const quint64 target     = qMax<quint64>(1, static_cast<quint64>(qCeil(static_cast<double>(count) * qBound(0.0, percentile, 100.0) / 100.0)));
+    quint64       cumulative = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            // 桶的上界（微秒）换算为毫秒，不超过实际的最长耗时
+            const double upperMs = static_cast<double>(quint64(1) << i) / 1000.0;
+            return qMin(upperMs, maxMs());
+        }
+    }
+    return maxMs();
+}
+
+QJsonObject HistogramSnapshot::toJson() const {
+    return {
+            {"count", static_cast<qint64>(count)},
+            {"meanMs", meanMs()},
+            {"p50Ms", percentileMs(50)},
+            {"p95Ms", percentileMs(95)},
+            {"p99Ms", percentileMs(99)},
+            {"maxMs", maxMs()},
+    };
+}
+
+// ========== StatsSnapshot ==========
+
+QJsonObject StatsSnapshot::toJson() const {
+    QJsonObject counterObject;
+    for (int i = 0; i < Counter_Count; ++i) {
+        counterObject.insert(QLatin1String(kCounterNames[i]), counters[i]);
+    }
+    QJsonObject gaugeObject;
+    for (int i = 0; i < Gauge_Count; ++i) {
+        gaugeObject.insert(QLatin1String(kGaugeNames[i]), gauges[i]);
+    }
+    QJsonObject histogramObject;
+    for (int i = 0; i < Histogram_Count; ++i) {
+        histogramObject.insert(QLatin1String(kHistogramNames[i]), histograms[i].toJson());
+    }
+    return {
+            {"name", name},
+            {"counters", counterObject},
+            {"gauges", gaugeObject},
+            {"histograms", histogramObject},
+    };
+}
+
+// ========== StatsBlock ==========
+
+StatsBlock::StatsBlock(const QString &name, StatsBlock *parent)
+    : _name(name)
+    , _parent(parent) {
+}
+
+void StatsBlock::add(const StatsCounter counter, const qint64 delta) {
+    if (!Stats::isEnabled()) {
+        return;
+    }
+    for (StatsBlock *block = this; block; block = block->_parent) {
+        block->_counters[counter].fetch_add(delta, std::memory_order_relaxed);
+    }
+}
+
+void StatsBlock::setGauge(const StatsGauge gauge, const qint64 value) {
+    _gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void StatsBlock::record(const StatsHistogram histogram, const qint64 nsecs) {
+    if (!Stats::isEnabled()) {
+        return;
+    }
+    const int bucket = bucketFor(nsecs);
+    for (StatsBlock *block = this; block; block = block->_parent) {
+        Histogram &h = block->_histograms[histogram];
+        h.count.fetch_add(1, std::memory_order_relaxed);
+        h.totalNs.fetch_add(nsecs, std::memory_order_relaxed);
+        h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        updateMax(h.maxNs, nsecs);
+    }
+}
+
+StatsSnapshot StatsBlock::snapshot() const {
+    StatsSnapshot snapshot;
+    snapshot.name = getName();
+    for (int i = 0; i < Counter_Count; ++i) {
+        snapshot.counters[i] = _counters[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < Gauge_Count; ++i) {
+        snapshot.gauges[i] = _gauges[i].load(std::memory_order_relaxed);
+    }
+    for (int i = 0; i < Histogram_Count; ++i) {
+        const Histogram   &h   = _histograms[i];
+        HistogramSnapshot &out = snapshot.histograms[i];
+        out.count              = h.count.load(std::memory_order_relaxed);
+        out.totalNs            = h.totalNs.load(std::memory_order_relaxed);
+        out.maxNs              = h.maxNs.load(std::memory_order_relaxed);
+        for (int b = 0; b < HistogramSnapshot::BucketCount; ++b) {
+            out.buckets[b] = h.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void StatsBlock::reset() {
+    for (auto &counter : _counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (Histogram &h : _histograms) {
+        h.count.store(0, std::memory_order_relaxed);
+        h.totalNs.store(0, std::memory_order_relaxed);
+        h.maxNs.store(0, std::memory_order_relaxed);
+        for (auto &bucket : h.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void StatsBlock::setName(const QString &name) {
+    QMutexLocker locker(&_nameMutex);
+    _name = name;
+}
+
+QString StatsBlock::getName() const {
+    QMutexLocker locker(&_nameMutex);
+    return _name;
+}
+
+// ========== StatsScope ==========
+
+StatsScope::StatsScope(std::shared_ptr<StatsBlock> block)
+    : _previous(std::move(t_current)) {
+    t_current = std::move(block);
+}
+
+StatsScope::~StatsScope() {
+    t_current = std::move(_previous);
+}
+
+StatsBlock *StatsScope::current() {
+    return t_current ? t_current.get() : &Stats::instance().global();
+}
+
+std::shared_ptr<StatsBlock> StatsScope::currentShared() {
+    return t_current;
+}
+
+// ========== Stats ==========
+
+Stats &Stats::instance() {
+    static Stats *stats = new Stats();
+    return *stats;
+}
+
+Stats::Stats()
+    : _global(QStringLiteral("global"))
+    , _reportTimer(new QTimer(this)) {
+    qRegisterMetaType<Mel::StatsSnapshot>();
+
+    // 第一次访问可能来自后台线程（ImageLoader），定时器必须属于主线程
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        moveToThread(app->thread());
+    }
+    connect(_reportTimer, &QTimer::timeout, this, [this]() { Q_EMIT reported(globalSnapshot()); });
+}
+
+void Stats::setEnabled(const bool enabled) {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Stats::isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<StatsBlock> Stats::createBlock(const QString &name) {
+    auto block = std::make_shared<StatsBlock>(name, &_global);
+
+    QMutexLocker locker(&_mutex);
+    pruneBlocks();
+    _blocks.push_back(block);
+    return block;
+}
+
+StatsSnapshot Stats::globalSnapshot() const {
+    StatsSnapshot snapshot = _global.snapshot();
+
+    QMutexLocker locker(&_mutex);
+    pruneBlocks();
+    for (const auto &weak : _blocks) {
+        if (const auto block = weak.lock()) {
+            const StatsSnapshot part = block->snapshot();
+            for (int i = 0; i < Gauge_Count; ++i) {
+                snapshot.gauges[i] += part.gauges[i];
+            }
+        }
+    }
+    return snapshot;
+}
+
+QList<StatsSnapshot> Stats::blockSnapshots() const {
+    QList<StatsSnapshot> snapshots;
+
+    QMutexLocker locker(&_mutex);
+    pruneBlocks();
+    for (const auto &weak : _blocks) {
+        if (const auto block = weak.lock()) {
+            snapshots.append(block->snapshot());
+        }
+    }
+    return snapshots;
+}
+
+void Stats::reset() {
+    _global.reset();
+
+    QMutexLocker locker(&_mutex);
+    for (const auto &weak : _blocks) {
+        if (const auto block = weak.lock()) {
+            block->reset();
+        }
+    }
+}
+
+void Stats::setReportInterval(const int msec) {
+    if (msec > 0) {
+        _reportTimer->start(msec);
+    } else {
+        _reportTimer->stop();
+    }
+}
+
+int Stats::getReportInterval() const {
+    return _reportTimer->isActive() ? _reportTimer->interval() : 0;
+}
+
+void Stats::pruneBlocks() const {
+    _blocks.erase(std::remove_if(_blocks.begin(), _blocks.end(), [](const std::weak_ptr<StatsBlock> &weak) { return weak.expired(); }), _blocks.end());
+}
+
+} // namespace Mel
@@ -0,0 +1,324 @@
+/**
+ * @file Stats.h
+ * @brief 运行时性能统计 - 按控件和全局记录计数器、当前值和耗时直方图
+ */
+
+#ifndef MEL_STATS_H
+#define MEL_STATS_H
+
+#include "Mel_export.h"
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaType>
+#include <QMutex>
+#include <QObject>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+namespace Mel {
+
+/**
+ * @brief 计数器（只增不减）
+ */
+enum StatsCounter {
+    Counter_Decodes = 0,       // 解码次数
+    Counter_Scales,            // 缩放次数
+    Counter_Paints,            // 绘制次数
+    Counter_TransitionFrames,  // 过渡动画绘制的帧数
+    Counter_TransitionDropped, // 过渡动画掉帧数
+    Counter_BudgetEvictions,   // 超出像素内存预算时释放缓冲区的次数
+    Counter_Count
+};
+
+/**
+ * @brief 当前值
+ */
+enum StatsGauge {
+    Gauge_PixelBytes = 0, // 持有的像素缓冲区字节数
+    Gauge_Count
+};
+
+/**
+ * @brief 耗时直方图
+ */
+enum StatsHistogram {
+    Histogram_DecodeTime = 0, // 解码耗时
+    Histogram_ScaleTime,      // 缩放耗时
+    Histogram_PaintTime,      // 每帧绘制耗时
+    Histogram_BlurTime,       // 模糊耗时
+    Histogram_Count
+};
+
+/**
+ * @brief 耗时直方图的快照
+ *
+ * 按微秒取以 2 为底的对数分桶：第 0 个桶为不足 1 微秒，第 i 个桶为 [2^(i-1), 2^i) 微秒，最后一个桶包含更长的耗时
+ */
+struct MEL_EXPORT HistogramSnapshot {
+    static constexpr int BucketCount = 24;
+
+    quint64                          count   = 0; // 记录次数
+    qint64                           totalNs = 0; // 累计耗时（纳秒）
+    qint64                           maxNs   = 0; // 最长耗时（纳秒）
+    std::array<quint64, BucketCount> buckets{};   // 各桶的次数
+
+    /**
+     * @brief 平均耗时（毫秒）
+     */
+    [[nodiscard]] double meanMs() const;
+
+    /**
+     * @brief 最长耗时（毫秒）
+     */
+    [[nodiscard]] double maxMs() const { return static_cast<double>(maxNs) / 1e6; }
+
+    /**
+     * @brief 估算百分位耗时（毫秒，取所在桶的上界）
+     * @param percentile 百分位（0-100）
+     */
+    [[nodiscard]] double percentileMs(double percentile) const;
+
+    /**
+     * @brief 转换为 JSON（次数、平均、P50/P95/P99、最长）
+     */
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+/**
+ * @brief 一组统计的快照
+ */
+struct MEL_EXPORT StatsSnapshot {
+    QString                                        name;         // 名称（控件为对象名）
+    std::array<qint64, Counter_Count>              counters{};   // 计数器
+    std::array<qint64, Gauge_Count>                gauges{};     // 当前值
+    std::array<HistogramSnapshot, Histogram_Count> histograms{}; // 耗时直方图
+
+    [[nodiscard]] qint64 counter(const StatsCounter which) const { return counters[which]; }
+
+    [[nodiscard]] qint64 gauge(const StatsGauge which) const { return gauges[which]; }
+
+    [[nodiscard]] const HistogramSnapshot &histogram(const StatsHistogram which) const { return histograms[which]; }
+
+    /**
+     * @brief 转换为 JSON
+     */
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+/**
+ * @brief 一组统计（一个控件或全局）
+ *
+ * 记录只使用宽松的原子操作，可以在任意线程中调用；记录到子组的计数器和直方图同时计入父组（全局），
+ * 当前值只属于各自的组，全局快照中为所有组的合计
+ */
+class MEL_EXPORT StatsBlock {
+public:
+    explicit StatsBlock(const QString &name, StatsBlock *parent = nullptr);
+
+    StatsBlock(const StatsBlock &) = delete;
+
+    StatsBlock &operator=(const StatsBlock &) = delete;
+
+    /**
+     * @brief 增加计数器
+     */
+    void add(StatsCounter counter, qint64 delta = 1);
+
+    /**
+     * @brief 设置当前值
+     */
+    void setGauge(StatsGauge gauge, qint64 value);
+
+    /**
+     * @brief 记录一次耗时
+     * @param nsecs 耗时（纳秒）
+     */
+    void record(StatsHistogram histogram, qint64 nsecs);
+
+    /**
+     * @brief 获取快照
+     */
+    [[nodiscard]] StatsSnapshot snapshot() const;
+
+    /**
+     * @brief 清零计数器和直方图（当前值保留）
+     */
+    void reset();
+
+    /**
+     * @brief 设置名称
+     */
+    void setName(const QString &name);
+
+    /**
+     * @brief 获取名称
+     */
+    [[nodiscard]] QString getName() const;
+
+private:
+    struct Histogram {
+        std::atomic<quint64>                                             count{0};
+        std::atomic<qint64>                                              totalNs{0};
+        std::atomic<qint64>                                              maxNs{0};
+        std::array<std::atomic<quint64>, HistogramSnapshot::BucketCount> buckets{};
+    };
+
+    mutable QMutex                                 _nameMutex;  // 保护名称
+    QString                                        _name;       // 名称
+    StatsBlock                                    *_parent;     // 父组（全局）
+    std::array<std::atomic<qint64>, Counter_Count> _counters{}; // 计数器
+    std::array<std::atomic<qint64>, Gauge_Count>   _gauges{};   // 当前值
+    std::array<Histogram, Histogram_Count>         _histograms; // 耗时直方图
+};
+
+/**
+ * @brief 统计归属范围
+ *
+ * 在当前线程中把 ImageLoader、Resampler 等库级函数记录的耗时同时计入指定的组（例如某个控件），
+ * 范围结束时恢复之前的归属。ImageLoader::loadAsync 会把发起时的归属带到后台任务中
+ */
+class MEL_EXPORT StatsScope {
+public:
+    explicit StatsScope(std::shared_ptr<StatsBlock> block);
+
+    ~StatsScope();
+
+    StatsScope(const StatsScope &) = delete;
+
+    StatsScope &operator=(const StatsScope &) = delete;
+
+    /**
+     * @brief 当前线程的统计归属（未设置时为全局）
+     */
+    [[nodiscard]] static StatsBlock *current();
+
+    /**
+     * @brief 当前线程的统计归属（未设置时为空，用于传递给后台任务）
+     */
+    [[nodiscard]] static std::shared_ptr<StatsBlock> currentShared();
+
+private:
+    std::shared_ptr<StatsBlock> _previous; // 之前的归属
+};
+
+/**
+ * @brief 作用域计时：析构时把经过的时间记录到直方图
+ */
+class StatsTimer {
+public:
+    explicit StatsTimer(const StatsHistogram histogram, StatsBlock *block = StatsScope::current())
+        : _block(block)
+        , _histogram(histogram) {
+        _timer.start();
+    }
+
+    ~StatsTimer() {
+        if (_block) {
+            _block->record(_histogram, _timer.nsecsElapsed());
+        }
+    }
+
+    StatsTimer(const StatsTimer &) = delete;
+
+    StatsTimer &operator=(const StatsTimer &) = delete;
+
+private:
+    StatsBlock    *_block;     // 记录到的组
+    StatsHistogram _histogram; // 直方图
+    QElapsedTimer  _timer;     // 计时
+};
+
+/**
+ * @brief 运行时性能统计
+ *
+ * - global() 为全局统计，createBlock() 为每个控件创建一组统计（控件销毁后自动移除）
+ * - 可随时通过 globalSnapshot() / blockSnapshots() 查询
+ * - setReportInterval() 开启后按间隔发出 reported 信号
+ * - setEnabled(false) 后所有记录直接返回
+ */
+class MEL_EXPORT Stats : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 获取统计实例（第一次调用须在主线程）
+     */
+    static Stats &instance();
+
+    /**
+     * @brief 设置是否记录（默认开启）
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief 是否记录
+     */
+    [[nodiscard]] static bool isEnabled();
+
+    /**
+     * @brief 获取全局统计
+     */
+    [[nodiscard]] StatsBlock &global() { return _global; }
+
+    /**
+     * @brief 创建一组统计（计入全局）
+     * @param name 名称
+     */
+    [[nodiscard]] std::shared_ptr<StatsBlock> createBlock(const QString &name);
+
+    /**
+     * @brief 获取全局快照（当前值为所有组的合计）
+     */
+    [[nodiscard]] StatsSnapshot globalSnapshot() const;
+
+    /**
+     * @brief 获取所有组的快照
+     */
+    [[nodiscard]] QList<StatsSnapshot> blockSnapshots() const;
+
+    /**
+     * @brief 清零全局和所有组的计数器与直方图
+     */
+    void reset();
+
+    /**
+     * @brief 设置定期报告的间隔
+     * @param msec 间隔（毫秒），设为0关闭（默认）
+     */
+    void setReportInterval(int msec);
+
+    /**
+     * @brief 获取定期报告的间隔（毫秒）
+     */
+    [[nodiscard]] int getReportInterval() const;
+
+Q_SIGNALS:
+    /**
+     * @brief 定期报告
+     * @param global 全局快照
+     */
+    void reported(const Mel::StatsSnapshot &global);
+
+private:
+    Stats();
+
+    /**
+     * @brief 移除已销毁的组（调用时须持有锁）
+     */
+    void pruneBlocks() const;
+
+    StatsBlock                                     _global;      // 全局统计
+    mutable QMutex                                 _mutex;       // 保护组列表
+    mutable std::vector<std::weak_ptr<StatsBlock>> _blocks;      // 各组
+    QTimer                                        *_reportTimer; // 定期报告定时器
+};
+
+} // namespace Mel
+
+Q_DECLARE_METATYPE(Mel::StatsSnapshot)
+
+#endif // MEL_STATS_H
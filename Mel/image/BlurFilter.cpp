@@ -0,0 +1,273 @@
+/**
+ * @file BlurFilter.cpp
+ * @brief 模糊滤镜实现
+ */
+
+#include "BlurFilter.h"
+#include "ImageLoader.h"
+#include "core/Parallel.h"
+#include "core/Simd.h"
+#include "core/Stats.h"
+#include <QThread>
+#include <QVector>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace Mel {
+
+namespace {
+
+constexpr int PassCount           = 3;  // 盒式模糊的遍数
+constexpr int MinRowsPerThread    = 32; // 每个线程至少处理的行数
+constexpr int MinColumnsPerThread = 64; // 每个线程至少处理的列数
+
+/**
+ * @brief 按标准差计算三遍盒式模糊各自的半径（遍数足够时盒式模糊的叠加趋近高斯分布）
+ */
+std::array<int, PassCount> boxRadii(const double sigma) {
+    const double ideal = std::sqrt(12.0 * sigma * sigma / PassCount + 1.0);
+    int          lower = static_cast<int>(std::floor(ideal));
+    if (lower % 2 == 0) {
+        --lower;
+    }
+    const int upper = lower + 2;
+
+    // 前 count 遍使用较小的窗口，其余使用较大的窗口，使总方差最接近 sigma^2
+    const double idealCount = (12.0 * sigma * sigma - PassCount * lower * lower - 4.0 * PassCount * lower - 3.0 * PassCount) / (-4.0 * lower - 4.0);
+    const int    count      = qRound(idealCount);
+
+    std::array<int, PassCount> radii{};
+    for (int i = 0; i < PassCount; ++i) {
+        radii[i] = ((i < count ? lower : upper) - 1) / 2;
+    }
+    return radii;
+}
+
+// ========== 标量内核（参考实现） ==========
+
+/**
+ * @brief 窗口内的通道和取平均后打包（与 SIMD 内核使用相同的单精度运算）
+ */
+inline quint32 packAverage(const int *acc, const float scale) {
+    quint32 pixel = 0;
+    for (int ch = 0; ch < 4; ++ch) {
+        pixel |= static_cast<quint32>(static_cast<int>(static_cast<float>(acc[ch]) * scale + 0.5f)) << (ch * 8);
+    }
+    return pixel;
+}
+
+/**
+ * @brief 窗口滑动一个像素：加入 incoming，移出 outgoing
+ */
+inline void slide(int *acc, const quint32 incoming, const quint32 outgoing) {
+    for (int ch = 0; ch < 4; ++ch) {
+        acc[ch] += static_cast<int>((incoming >> (ch * 8)) & 0xFF) - static_cast<int>((outgoing >> (ch * 8)) & 0xFF);
+    }
+}
+
+void boxRowScalar(const quint32 *src, quint32 *dst, const int width, const int radius) {
+    const float scale  = 1.0f / static_cast<float>(2 * radius + 1);
+    int         acc[4] = {0, 0, 0, 0};
+    for (int k = -radius; k <= radius; ++k) {
+        slide(acc, src[qBound(0, k, width - 1)], 0);
+    }
+    for (int x = 0; x < width; ++x) {
+        dst[x] = packAverage(acc, scale);
+        slide(acc, src[qMin(x + radius + 1, width - 1)], src[qMax(x - radius, 0)]);
+    }
+}
+
+void boxColumnsScalar(const uchar *src, const qsizetype srcStride, uchar *dst, const qsizetype dstStride, const int height, const int begin, const int end, const int radius) {
+    const float      scale = 1.0f / static_cast<float>(2 * radius + 1);
+    const int        count = end - begin;
+    std::vector<int> acc(static_cast<size_t>(count) * 4, 0);
+    auto             row = [&](const int y) { return reinterpret_cast<const quint32 *>(src + qBound(0, y, height - 1) * srcStride) + begin; };
+
+    for (int k = -radius; k <= radius; ++k) {
+        const quint32 *in = row(k);
+        for (int x = 0; x < count; ++x) {
+            slide(&acc[x * 4], in[x], 0);
+        }
+    }
+    for (int y = 0; y < height; ++y) {
+        auto          *out      = reinterpret_cast<quint32 *>(dst + y * dstStride) + begin;
+        const quint32 *incoming = row(y + radius + 1);
+        const quint32 *outgoing = row(y - radius);
+        for (int x = 0; x < count; ++x) {
+            out[x] = packAverage(&acc[x * 4], scale);
+            slide(&acc[x * 4], incoming[x], outgoing[x]);
+        }
+    }
+}
+
+// ========== SIMD 内核 ==========
+
+#ifdef MEL_SIMD_X86
+
+/**
+ * @brief 一个像素展开为 4 个 32 位通道
+ */
+MEL_TARGET_SSE2 inline __m128i unpackPixel(const quint32 pixel) {
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(pixel)), zero), zero);
+}
+
+/**
+ * @brief 4 个 32 位通道和取平均（返回 32 位结果，由调用方打包）
+ */
+MEL_TARGET_SSE2 inline __m128i averageSse2(const __m128i acc, const __m128 scale) {
+    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(acc), scale), _mm_set1_ps(0.5f)));
+}
+
+MEL_TARGET_SSE2 void boxRowSse2(const quint32 *src, quint32 *dst, const int width, const int radius) {
+    const __m128 scale = _mm_set1_ps(1.0f / static_cast<float>(2 * radius + 1));
+    __m128i      acc   = _mm_setzero_si128();
+    for (int k = -radius; k <= radius; ++k) {
+        acc = _mm_add_epi32(acc, unpackPixel(src[qBound(0, k, width - 1)]));
+    }
+    for (int x = 0; x < width; ++x) {
+        __m128i average = averageSse2(acc, scale);
+        average         = _mm_packs_epi32(average, average);
+        dst[x]          = static_cast<quint32>(_mm_cvtsi128_si32(_mm_packus_epi16(average, average)));
+        acc             = _mm_add_epi32(acc, _mm_sub_epi32(unpackPixel(src[qMin(x + radius + 1, width - 1)]), unpackPixel(src[qMax(x - radius, 0)])));
+    }
+}
+
+MEL_TARGET_SSE2 void boxColumnsSse2(const uchar *src, const qsizetype srcStride, uchar *dst, const qsizetype dstStride, const int height, const int begin, const int end, const int radius) {
+    const __m128        scale = _mm_set1_ps(1.0f / static_cast<float>(2 * radius + 1));
+    const __m128i       zero  = _mm_setzero_si128();
+    const int           count = end - begin;
+    std::vector<qint32>  sums(static_cast<size_t>(count) * 4, 0); // 每个像素 4 个 32 位通道
+    auto                acc = [&sums](const int x) { return reinterpret_cast<__m128i *>(sums.data() + x * 4); };
+    auto                row = [&](const int y) { return reinterpret_cast<const quint32 *>(src + qBound(0, y, height - 1) * srcStride) + begin; };
+
+    for (int k = -radius; k <= radius; ++k) {
+        const quint32 *in = row(k);
+        for (int x = 0; x < count; ++x) {
+            _mm_storeu_si128(acc(x), _mm_add_epi32(_mm_loadu_si128(acc(x)), unpackPixel(in[x])));
+        }
+    }
+
+    for (int y = 0; y < height; ++y) {
+        auto          *out      = reinterpret_cast<quint32 *>(dst + y * dstStride) + begin;
+        const quint32 *incoming = row(y + radius + 1);
+        const quint32 *outgoing = row(y - radius);
+
+        int x = 0;
+        for (; x + 4 <= count; x += 4) {
+            const __m128i s0 = _mm_loadu_si128(acc(x));
+            const __m128i s1 = _mm_loadu_si128(acc(x + 1));
+            const __m128i s2 = _mm_loadu_si128(acc(x + 2));
+            const __m128i s3 = _mm_loadu_si128(acc(x + 3));
+
+            // 4 个像素的平均值一起打包写出
+            const __m128i a01 = _mm_packs_epi32(averageSse2(s0, scale), averageSse2(s1, scale));
+            const __m128i a23 = _mm_packs_epi32(averageSse2(s2, scale), averageSse2(s3, scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x), _mm_packus_epi16(a01, a23));
+
+            // 进出窗口的差值在 16 位内计算（范围 [-255, 255]），再符号扩展到 32 位
+            const __m128i in  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(incoming + x));
+            const __m128i old = _mm_loadu_si128(reinterpret_cast<const __m128i *>(outgoing + x));
+            const __m128i dlo = _mm_sub_epi16(_mm_unpacklo_epi8(in, zero), _mm_unpacklo_epi8(old, zero));
+            const __m128i dhi = _mm_sub_epi16(_mm_unpackhi_epi8(in, zero), _mm_unpackhi_epi8(old, zero));
+            _mm_storeu_si128(acc(x), _mm_add_epi32(s0, _mm_srai_epi32(_mm_unpacklo_epi16(dlo, dlo), 16)));
+            _mm_storeu_si128(acc(x + 1), _mm_add_epi32(s1, _mm_srai_epi32(_mm_unpackhi_epi16(dlo, dlo), 16)));
+            _mm_storeu_si128(acc(x + 2), _mm_add_epi32(s2, _mm_srai_epi32(_mm_unpacklo_epi16(dhi, dhi), 16)));
+            _mm_storeu_si128(acc(x + 3), _mm_add_epi32(s3, _mm_srai_epi32(_mm_unpackhi_epi16(dhi, dhi), 16)));
+        }
+        for (; x < count; ++x) {
+            const __m128i sum     = _mm_loadu_si128(acc(x));
+            __m128i       average = averageSse2(sum, scale);
+            average               = _mm_packs_epi32(average, average);
+            out[x]                = static_cast<quint32>(_mm_cvtsi128_si32(_mm_packus_epi16(average, average)));
+            _mm_storeu_si128(acc(x), _mm_add_epi32(sum, _mm_sub_epi32(unpackPixel(incoming[x]), unpackPixel(outgoing[x]))));
+        }
+    }
+}
+
+#endif // MEL_SIMD_X86
+
+// ========== 调度 ==========
+
+using RowKernel    = void (*)(const quint32 *, quint32 *, int, int);
+using ColumnKernel = void (*)(const uchar *, qsizetype, uchar *, qsizetype, int, int, int, int);
+
+struct Kernels {
+    RowKernel    row;
+    ColumnKernel columns;
+};
+
+Kernels kernelsFor(const Resampler::SimdLevel level) {
+#ifdef MEL_SIMD_X86
+    // 滑动窗口每个像素只有一次加减，AVX2 相比 SSE2 没有明显收益
+    if (level >= Resampler::Simd_SSE2) {
+        return {boxRowSse2, boxColumnsSse2};
+    }
+#else
+    Q_UNUSED(level);
+#endif
+    return {boxRowScalar, boxColumnsScalar};
+}
+
+} // namespace
+
+QImage BlurFilter::blur(const QImage &source, const int radius) {
+    return blur(source, radius, Resampler::detectSimdLevel(), 0);
+}
+
+QImage BlurFilter::blur(const QImage &image, const int radius, const Resampler::SimdLevel simdLevel, const int threadCount) {
+    if (image.isNull()) {
+        return {};
+    }
+
+    const QImage                     source = ImageLoader::toDisplayFormat(image);
+    const std::array<int, PassCount> radii  = boxRadii(qBound(0, radius, MaxRadius) / 2.0);
+    if (radii[PassCount - 1] <= 0) {
+        return source;
+    }
+
+    StatsTimer timer(Histogram_BlurTime);
+
+    const int     width   = source.width();
+    const int     height  = source.height();
+    const int     threads = threadCount > 0 ? threadCount : qMax(1, QThread::idealThreadCount());
+    const Kernels kernels = kernelsFor(qMin(simdLevel, Resampler::detectSimdLevel()));
+
+    // 水平方向：每一行连续做三遍，中间结果只需要两行缓冲区
+    QImage horizontal(source.size(), source.format());
+    uchar *horizontalBits = horizontal.bits();
+    parallelFor(height, threads, MinRowsPerThread, [&](const int begin, const int end) {
+        QVector<quint32> first(width);
+        QVector<quint32> second(width);
+        for (int y = begin; y < end; ++y) {
+            kernels.row(reinterpret_cast<const quint32 *>(source.constScanLine(y)), first.data(), width, radii[0]);
+            kernels.row(first.constData(), second.data(), width, radii[1]);
+            kernels.row(second.constData(), reinterpret_cast<quint32 *>(horizontalBits + y * horizontal.bytesPerLine()), width, radii[2]);
+        }
+    });
+
+    // 垂直方向：按列段并行，每遍在两张图片之间交替
+    QImage buffers[2] = {std::move(horizontal), QImage(source.size(), source.format())};
+    for (int pass = 0; pass < PassCount; ++pass) {
+        const QImage &in         = buffers[pass % 2];
+        QImage       &out        = buffers[(pass + 1) % 2];
+        const uchar  *inBits     = in.constBits();
+        uchar        *outBits    = out.bits();
+        const int     passRadius = radii[pass];
+        parallelFor(width, threads, MinColumnsPerThread, [&](const int begin, const int end) {
+            kernels.columns(inBits, in.bytesPerLine(), outBits, out.bytesPerLine(), height, begin, end, passRadius);
+        });
+    }
+
+    QImage result = buffers[PassCount % 2];
+    result.setDevicePixelRatio(image.devicePixelRatio());
+    return result;
+}
+
+QImage BlurFilter::blurReference(const QImage &source, const int radius) {
+    return blur(source, radius, Resampler::Simd_Scalar, 1);
+}
+
+} // namespace Mel
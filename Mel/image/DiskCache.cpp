@@ -0,0 +1,258 @@
+/**
+ * @file DiskCache.cpp
+ * @brief 磁盘缓存实现
+ */
+
+#include "DiskCache.h"
+#include "PixelContainer.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+namespace Mel {
+
+namespace {
+
+constexpr qint64 DefaultBudget = 256LL * 1024 * 1024; // 默认预算 256 MB
+constexpr qint64 StaleTempAge  = 10LL * 60 * 1000;    // 临时文件超过该时间（毫秒）仍未完成视为写入中断
+
+QString defaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/Mel/scaled");
+}
+
+/**
+ * @brief 更新文件修改时间（淘汰顺序按修改时间计算）
+ */
+void touchFile(const QString &path) {
+    QFile file(path);
+    if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+}
+
+/**
+ * @brief 清理中断的临时文件，并按修改时间从旧到新删除缓存文件，直到满足预算
+ * @return 删除的文件数
+ */
+quint64 evictDirectory(const QString &directory, const qint64 budget) {
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QFileInfoList files;
+    qint64        total   = 0;
+    quint64       removed = 0;
+    for (const QFileInfo &info : QDir(directory).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed)) {
+        if (!info.fileName().endsWith(PixelContainer::suffix())) {
+            // QSaveFile 的临时文件：写入中的文件很新，只删除过期的
+            if (info.lastModified().msecsTo(now) > StaleTempAge && QFile::remove(info.filePath())) {
+                ++removed;
+            }
+            continue;
+        }
+        files.append(info);
+        total += info.size();
+    }
+
+    // 正在被映射的文件在部分平台上无法删除，跳过后继续删除下一个
+    for (const QFileInfo &info : files) {
+        if (total <= budget) {
+            break;
+        }
+        if (QFile::remove(info.filePath())) {
+            total -= info.size();
+            ++removed;
+        }
+    }
+    return removed;
+}
+
+} // namespace
+
+struct DiskCache::Private {
+    mutable QMutex mutex;
+
+    bool           enabled = false;
+    QString        directory; // 为空时使用默认目录
+    qint64         budget = DefaultBudget;
+    DiskCacheStats stats;
+
+    QString currentDirectory() const {
+        return directory.isEmpty() ? defaultDirectory() : directory;
+    }
+
+    /**
+     * @brief 缓存键对应的文件路径（键的 SHA-1 作为文件名）
+     */
+    QString filePath(const QString &key) const {
+        const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+        return currentDirectory() + QLatin1Char('/') + QString::fromLatin1(hash) + PixelContainer::suffix();
+    }
+};
+
+DiskCache &DiskCache::instance() {
+    static DiskCache cache;
+    return cache;
+}
+
+DiskCache::DiskCache() :
+    _d(std::make_unique<Private>()) {
+}
+
+DiskCache::~DiskCache() = default;
+
+// ========== 设置 ==========
+
+void DiskCache::setEnabled(const bool enabled) {
+    QMutexLocker locker(&_d->mutex);
+    _d->enabled = enabled;
+}
+
+bool DiskCache::isEnabled() const {
+    QMutexLocker locker(&_d->mutex);
+    return _d->enabled;
+}
+
+void DiskCache::setDirectory(const QString &path) {
+    QMutexLocker locker(&_d->mutex);
+    _d->directory = path;
+}
+
+QString DiskCache::getDirectory() const {
+    QMutexLocker locker(&_d->mutex);
+    return _d->currentDirectory();
+}
+
+void DiskCache::setBudget(const qint64 bytes) {
+    QString directory;
+    {
+        QMutexLocker locker(&_d->mutex);
+        _d->budget = qMax<qint64>(0, bytes);
+        directory  = _d->currentDirectory();
+    }
+
+    const quint64 removed = evictDirectory(directory, qMax<qint64>(0, bytes));
+    QMutexLocker  locker(&_d->mutex);
+    _d->stats.evictions += removed;
+}
+
+qint64 DiskCache::getBudget() const {
+    QMutexLocker locker(&_d->mutex);
+    return _d->budget;
+}
+
+// ========== 缩放图 ==========
+
+QImage DiskCache::findScaled(const QString &scaledKey, QSize *sourceSize) {
+    QString path;
+    {
+        QMutexLocker locker(&_d->mutex);
+        if (!_d->enabled || scaledKey.isEmpty()) {
+            return {};
+        }
+        path = _d->filePath(scaledKey);
+    }
+
+    // 文件 IO 不持有锁
+    QImage image;
+    bool   corrupt = false;
+    if (QFile::exists(path)) {
+        PixelContainer container;
+        if (container.open(path) && container.levelCount() > 0) {
+            image = container.level(0);
+            if (sourceSize) {
+                *sourceSize = container.getSourceSize();
+            }
+            touchFile(path);
+        } else {
+            // 截断或格式不符（例如其他版本写入的文件），删除后按未命中处理
+            corrupt = QFile::remove(path);
+        }
+    }
+
+    QMutexLocker locker(&_d->mutex);
+    ++(image.isNull() ? _d->stats.misses : _d->stats.hits);
+    if (corrupt) {
+        ++_d->stats.evictions;
+    }
+    return image;
+}
+
+void DiskCache::insertScaled(const QString &scaledKey, const QImage &image, const QSize &sourceSize) {
+    if (scaledKey.isEmpty() || image.isNull()) {
+        return;
+    }
+
+    QString directory;
+    QString path;
+    qint64  budget = 0;
+    {
+        QMutexLocker locker(&_d->mutex);
+        if (!_d->enabled) {
+            return;
+        }
+        directory = _d->currentDirectory();
+        path      = _d->filePath(scaledKey);
+        budget    = _d->budget;
+    }
+
+    // 同一结果已由其他控件或之前的进程写入
+    if (QFile::exists(path)) {
+        touchFile(path);
+        return;
+    }
+
+    // 单个结果超过预算时不缓存
+    if (static_cast<qint64>(image.sizeInBytes()) > budget || !QDir().mkpath(directory)) {
+        return;
+    }
+
+    // QSaveFile 写完后才替换目标文件，中途退出不会留下不完整的缓存文件
+    if (!PixelContainer::write(path, {image}, sourceSize)) {
+        return;
+    }
+
+    const quint64 removed = evictDirectory(directory, budget);
+    QMutexLocker  locker(&_d->mutex);
+    ++_d->stats.writes;
+    _d->stats.evictions += removed;
+}
+
+void DiskCache::clear() {
+    const QDir directory(getDirectory());
+    for (const QString &name : directory.entryList(QDir::Files)) {
+        directory.remove(name);
+    }
+}
+
+// ========== 统计 ==========
+
+DiskCacheStats DiskCache::getStats() const {
+    DiskCacheStats stats;
+    QString        directory;
+    {
+        QMutexLocker locker(&_d->mutex);
+        stats        = _d->stats;
+        stats.budget = _d->budget;
+        directory    = _d->currentDirectory();
+    }
+
+    for (const QFileInfo &info : QDir(directory).entryInfoList({QLatin1Char('*') + PixelContainer::suffix()}, QDir::Files)) {
+        ++stats.fileCount;
+        stats.bytes += info.size();
+    }
+    return stats;
+}
+
+void DiskCache::resetStats() {
+    QMutexLocker locker(&_d->mutex);
+    _d->stats.hits      = 0;
+    _d->stats.misses    = 0;
+    _d->stats.writes    = 0;
+    _d->stats.evictions = 0;
+}
+
+} // namespace Mel
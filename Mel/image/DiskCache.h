@@ -0,0 +1,131 @@
+/**
+ * @file DiskCache.h
+ * @brief 磁盘缓存 - 跨进程保存按显示尺寸缩放好的背景，再次启动时直接映射而不解码
+ */
+
+#ifndef MEL_DISKCACHE_H
+#define MEL_DISKCACHE_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QString>
+#include <memory>
+
+namespace Mel {
+
+/**
+ * @brief 磁盘缓存统计信息
+ */
+struct MEL_EXPORT DiskCacheStats {
+    quint64 hits      = 0; // 命中次数
+    quint64 misses    = 0; // 未命中次数
+    quint64 writes    = 0; // 写入次数
+    quint64 evictions = 0; // 淘汰的文件数（含损坏的文件）
+    int     fileCount = 0; // 当前缓存文件数量
+    qint64  bytes     = 0; // 当前占用字节数
+    qint64  budget    = 0; // 字节预算
+};
+
+/**
+ * @brief 缩放结果的磁盘缓存（单例，线程安全，默认关闭）
+ *
+ * 以 ImageCache::scaledKey 为键（原图路径 + 内容哈希、目标尺寸、缩放模式、缩放质量、设备像素比），
+ * 每个缩放结果保存为一个 PixelContainer 文件：像素是可直接绘制的预乘格式，命中时映射文件即可使用，
+ * 不需要解码和缩放，也只有实际绘制的部分才会被换入内存。
+ *
+ * - 写入通过 QSaveFile 先写临时文件再原子替换，崩溃或写到一半退出只会留下临时文件，之后作为过期文件清理
+ * - 打开失败的文件（截断、格式不符、字节序不同）视为损坏并删除
+ * - 命中时更新文件修改时间，超出预算时按修改时间从旧到新淘汰
+ */
+class MEL_EXPORT DiskCache {
+public:
+    /**
+     * @brief 获取全局实例
+     */
+    static DiskCache &instance();
+
+    DiskCache(const DiskCache &) = delete;
+
+    DiskCache &operator=(const DiskCache &) = delete;
+
+    // ========== 设置 ==========
+
+    /**
+     * @brief 设置是否启用（默认关闭）
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief 是否启用
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief 设置缓存目录（默认为 QStandardPaths::CacheLocation 下的 Mel/scaled）
+     */
+    void setDirectory(const QString &path);
+
+    /**
+     * @brief 获取缓存目录
+     */
+    [[nodiscard]] QString getDirectory() const;
+
+    /**
+     * @brief 设置字节预算（默认 256 MB）
+     */
+    void setBudget(qint64 bytes);
+
+    /**
+     * @brief 获取字节预算
+     */
+    [[nodiscard]] qint64 getBudget() const;
+
+    // ========== 缩放图 ==========
+
+    /**
+     * @brief 查找缩放结果
+     * @param scaledKey 缩放结果的缓存键（ImageCache::scaledKey）
+     * @param sourceSize 可选，命中时写入原始图片尺寸
+     * @return 引用映射内存的图片，未命中或未启用时为空
+     */
+    QImage findScaled(const QString &scaledKey, QSize *sourceSize = nullptr);
+
+    /**
+     * @brief 写入缩放结果（已存在时只更新修改时间），写入后按预算淘汰
+     *
+     * 包含文件 IO，应在后台线程调用
+     * @param scaledKey 缩放结果的缓存键（ImageCache::scaledKey）
+     * @param image 缩放结果
+     * @param sourceSize 原始图片尺寸
+     */
+    void insertScaled(const QString &scaledKey, const QImage &image, const QSize &sourceSize);
+
+    /**
+     * @brief 删除所有缓存文件（正在使用的映射仍然有效）
+     */
+    void clear();
+
+    // ========== 统计 ==========
+
+    /**
+     * @brief 获取统计信息（扫描缓存目录）
+     */
+    [[nodiscard]] DiskCacheStats getStats() const;
+
+    /**
+     * @brief 重置命中/未命中/写入/淘汰计数
+     */
+    void resetStats();
+
+private:
+    DiskCache();
+
+    ~DiskCache();
+
+    struct Private;
+    std::unique_ptr<Private> _d;
+};
+
+} // namespace Mel
+
+#endif // MEL_DISKCACHE_H
@@ -0,0 +1,311 @@
+/**
+ * @file ImageCache.cpp
+ * @brief 进程级图片缓存实现
+ */
+
+#include "ImageCache.h"
+#include "ImageLoader.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <list>
+
+namespace Mel {
+
+namespace {
+
+constexpr qint64 DefaultBudget = 256LL * 1024 * 1024; // 默认预算 256 MB
+
+/**
+ * @brief 缓存条目
+ */
+struct CacheEntry {
+    QString key;        // 缓存键
+    QImage  image;      // 图片数据（仅原图）
+    QPixmap pixmap;     // 图片数据（仅缩放图）
+    QSize   sourceSize; // 原始图片尺寸（仅原图）
+    bool    scaled;     // 是否为缩放图
+};
+
+qint64 entryBytes(const CacheEntry &entry) {
+    if (entry.scaled) {
+        return ImageLoader::pixmapBytes(entry.pixmap);
+    }
+    return static_cast<qint64>(entry.image.sizeInBytes());
+}
+
+/**
+ * @brief 当前线程能否访问和释放缩放图（QPixmap 只能在 GUI 线程中使用）
+ */
+bool onGuiThread() {
+    const QCoreApplication *app = QCoreApplication::instance();
+    return app && QThread::currentThread() == app->thread();
+}
+
+} // namespace
+
+struct ImageCache::Private {
+    mutable QMutex mutex;
+
+    // LRU 队列：头部为最近使用
+    std::list<CacheEntry>                                 entries;
+    QHash<QString, std::list<CacheEntry>::iterator>       index;
+    QHash<QString, QString>                               contentHashes; // 路径+大小+修改时间 -> 缓存键
+
+    qint64          budget = DefaultBudget;
+    ImageCacheStats stats;
+
+    /**
+     * @brief 查找条目并移动到队列头部
+     */
+    CacheEntry *touch(const QString &key) {
+        const auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it.value());
+        return &entries.front();
+    }
+
+    void remove(const QString &key) {
+        const auto it = index.find(key);
+        if (it == index.end()) {
+            return;
+        }
+        account(*it.value(), -1);
+        entries.erase(it.value());
+        index.erase(it);
+    }
+
+    void insert(CacheEntry entry) {
+        remove(entry.key);
+        // 单个条目超过预算时不缓存
+        if (entryBytes(entry) > budget) {
+            return;
+        }
+        entries.push_front(std::move(entry));
+        index.insert(entries.front().key, entries.begin());
+        account(entries.front(), 1);
+        evict();
+    }
+
+    void account(const CacheEntry &entry, const int sign) {
+        stats.bytes += sign * entryBytes(entry);
+        (entry.scaled ? stats.scaledCount : stats.originalCount) += sign;
+    }
+
+    /**
+     * @brief 淘汰最近最少使用的条目，直到满足预算（工作线程中跳过缩放图）
+     */
+    void evict() {
+        const bool gui = onGuiThread();
+        auto       it  = entries.end();
+        while (stats.bytes > budget && it != entries.begin()) {
+            --it;
+            if (it->scaled && !gui) {
+                continue;
+            }
+            account(*it, -1);
+            index.remove(it->key);
+            it = entries.erase(it);
+            ++stats.evictions;
+        }
+    }
+};
+
+ImageCache &ImageCache::instance() {
+    static ImageCache cache;
+    return cache;
+}
+
+ImageCache::ImageCache() :
+    _d(std::make_unique<Private>()) {
+}
+
+ImageCache::~ImageCache() = default;
+
+// ========== 缓存键 ==========
+
+QString ImageCache::sourceKey(const QString &path) {
+    const QFileInfo info(path);
+    const QString   stamp = QStringLiteral("%1|%2|%3").arg(info.absoluteFilePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+
+    {
+        QMutexLocker locker(&_d->mutex);
+        const auto   it = _d->contentHashes.constFind(stamp);
+        if (it != _d->contentHashes.constEnd()) {
+            return it.value();
+        }
+    }
+
+    // 读取文件内容计算哈希（远比解码便宜，且每个文件只计算一次）
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&file)) {
+        return {};
+    }
+
+    const QString key = path + QLatin1Char('#') + QString::fromLatin1(hash.result().toHex());
+
+    QMutexLocker locker(&_d->mutex);
+    _d->contentHashes.insert(stamp, key);
+    return key;
+}
+
+QString ImageCache::scaledKey(const QString &sourceKey, const QSize &size, const int scaleMode, const int quality, const qreal devicePixelRatio, const QSize &decodedSize) {
+    QString key = QStringLiteral("%1|%2x%3|%4|%5|%6").arg(sourceKey).arg(size.width()).arg(size.height()).arg(scaleMode).arg(quality).arg(devicePixelRatio);
+    if (decodedSize.isValid()) {
+        key += QStringLiteral("|from%1x%2").arg(decodedSize.width()).arg(decodedSize.height());
+    }
+    return key;
+}
+
+// ========== 原图 ==========
+
+QImage ImageCache::findOriginal(const QString &sourceKey, const QSize &minimumSize, QSize *sourceSize) {
+    if (sourceKey.isEmpty()) {
+        return {};
+    }
+
+    QMutexLocker locker(&_d->mutex);
+    CacheEntry  *entry = _d->touch(sourceKey);
+
+    // 命中条件：缓存的图片满足所需尺寸（未指定时要求完整原图）
+    const bool hit = entry && (minimumSize.isEmpty() ? entry->image.size() == entry->sourceSize
+                                                     : entry->image.width() >= minimumSize.width() && entry->image.height() >= minimumSize.height());
+    if (!hit) {
+        ++_d->stats.originalMisses;
+        return {};
+    }
+
+    ++_d->stats.originalHits;
+    if (sourceSize) {
+        *sourceSize = entry->sourceSize;
+    }
+    return entry->image;
+}
+
+void ImageCache::insertOriginal(const QString &sourceKey, const QImage &image, const QSize &sourceSize) {
+    if (sourceKey.isEmpty() || image.isNull()) {
+        return;
+    }
+
+    QMutexLocker locker(&_d->mutex);
+    if (_d->budget <= 0) {
+        return;
+    }
+
+    // 已缓存更高分辨率的版本时保留原有条目
+    if (const CacheEntry *existing = _d->touch(sourceKey)) {
+        if (existing->image.width() >= image.width() && existing->image.height() >= image.height()) {
+            return;
+        }
+    }
+
+    _d->insert({sourceKey, image, QPixmap(), sourceSize, false});
+}
+
+// ========== 缩放图 ==========
+
+QPixmap ImageCache::findScaled(const QString &scaledKey) {
+    if (scaledKey.isEmpty() || !onGuiThread()) {
+        return {};
+    }
+
+    QMutexLocker      locker(&_d->mutex);
+    const CacheEntry *entry = _d->touch(scaledKey);
+    if (!entry) {
+        ++_d->stats.scaledMisses;
+        return {};
+    }
+
+    ++_d->stats.scaledHits;
+    return entry->pixmap;
+}
+
+void ImageCache::insertScaled(const QString &scaledKey, const QPixmap &pixmap) {
+    if (scaledKey.isEmpty() || pixmap.isNull() || !onGuiThread()) {
+        return;
+    }
+
+    QMutexLocker locker(&_d->mutex);
+    if (_d->budget <= 0) {
+        return;
+    }
+    _d->insert({scaledKey, QImage(), pixmap, QSize(), true});
+}
+
+void ImageCache::release(const QString &sourceKey) {
+    if (sourceKey.isEmpty()) {
+        return;
+    }
+
+    // 缩放图的键以原图键和分隔符开头
+    const QString scaledPrefix = sourceKey + QLatin1Char('|');
+
+    QMutexLocker locker(&_d->mutex);
+    for (auto it = _d->entries.begin(); it != _d->entries.end();) {
+        if (it->key == sourceKey || it->key.startsWith(scaledPrefix)) {
+            _d->account(*it, -1);
+            _d->index.remove(it->key);
+            it = _d->entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// ========== 预算与统计 ==========
+
+void ImageCache::setBudget(const qint64 bytes) {
+    QMutexLocker locker(&_d->mutex);
+    _d->budget = qMax<qint64>(0, bytes);
+    _d->evict();
+}
+
+qint64 ImageCache::getBudget() const {
+    QMutexLocker locker(&_d->mutex);
+    return _d->budget;
+}
+
+void ImageCache::clear() {
+    const bool gui = onGuiThread();
+
+    QMutexLocker locker(&_d->mutex);
+    for (auto it = _d->entries.begin(); it != _d->entries.end();) {
+        if (it->scaled && !gui) {
+            ++it;
+            continue;
+        }
+        _d->account(*it, -1);
+        _d->index.remove(it->key);
+        it = _d->entries.erase(it);
+    }
+}
+
+ImageCacheStats ImageCache::getStats() const {
+    QMutexLocker    locker(&_d->mutex);
+    ImageCacheStats stats = _d->stats;
+    stats.budget          = _d->budget;
+    return stats;
+}
+
+void ImageCache::resetStats() {
+    QMutexLocker locker(&_d->mutex);
+    _d->stats.originalHits   = 0;
+    _d->stats.originalMisses = 0;
+    _d->stats.scaledHits     = 0;
+    _d->stats.scaledMisses   = 0;
+    _d->stats.evictions      = 0;
+}
+
+} // namespace Mel
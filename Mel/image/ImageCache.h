@@ -0,0 +1,157 @@
+/**
+ * @file ImageCache.h
+ * @brief 进程级图片缓存 - 在多个 BackgroundWidget 之间共享解码和缩放结果
+ */
+
+#ifndef MEL_IMAGECACHE_H
+#define MEL_IMAGECACHE_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+#include <memory>
+
+namespace Mel {
+
+/**
+ * @brief 图片缓存统计信息
+ */
+struct MEL_EXPORT ImageCacheStats {
+    quint64 originalHits   = 0; // 原图命中次数
+    quint64 originalMisses = 0; // 原图未命中次数
+    quint64 scaledHits     = 0; // 缩放图命中次数
+    quint64 scaledMisses   = 0; // 缩放图未命中次数
+    quint64 evictions      = 0; // 淘汰次数
+    int     originalCount  = 0; // 当前缓存的原图数量
+    int     scaledCount    = 0; // 当前缓存的缩放图数量
+    qint64  bytes          = 0; // 当前占用字节数
+    qint64  budget         = 0; // 字节预算
+};
+
+/**
+ * @brief 进程级图片缓存（单例，线程安全）
+ *
+ * 两级缓存，共用同一个 LRU 队列和字节预算：
+ * - 原图：以路径 + 内容哈希为键，保存解码结果（可能是按显示尺寸缩小后的图片）
+ * - 缩放图：以原图键 + 目标尺寸 + 缩放模式 + 缩放质量 + 设备像素比（+ 解码尺寸）为键，
+ *   以 QPixmap 保存，命中的控件直接共享同一份像素数据；只能在 GUI 线程中查找和插入，
+ *   工作线程中的淘汰会跳过缩放图，留到下一次在 GUI 线程中访问缓存时处理
+ *
+ * 超出预算时按最近最少使用的顺序淘汰；预算设为 0 时禁用缓存
+ */
+class MEL_EXPORT ImageCache {
+public:
+    /**
+     * @brief 获取全局实例
+     */
+    static ImageCache &instance();
+
+    ImageCache(const ImageCache &) = delete;
+
+    ImageCache &operator=(const ImageCache &) = delete;
+
+    // ========== 缓存键 ==========
+
+    /**
+     * @brief 计算图片来源的缓存键（路径 + 文件内容哈希）
+     *
+     * 内容哈希按路径、大小和修改时间记忆，同一文件只读取一次
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @return 缓存键，文件无法读取时为空
+     */
+    QString sourceKey(const QString &path);
+
+    /**
+     * @brief 计算缩放结果的缓存键
+     * @param sourceKey 原图缓存键
+     * @param size 目标尺寸
+     * @param scaleMode 缩放模式（BackgroundScaleMode）
+     * @param quality 缩放质量（ScaleQuality）
+     * @param devicePixelRatio 设备像素比
+     * @param decodedSize 缩放所用图片的尺寸（按显示尺寸缩小解码时与原图不同，不同解码尺寸的结果互不混用；为空时不区分）
+     */
+    static QString scaledKey(const QString &sourceKey, const QSize &size, int scaleMode, int quality, qreal devicePixelRatio, const QSize &decodedSize = QSize());
+
+    // ========== 原图 ==========
+
+    /**
+     * @brief 查找原图
+     * @param sourceKey 原图缓存键
+     * @param minimumSize 需要的最小尺寸（为空时要求完整原图）
+     * @param sourceSize 可选，命中时写入原始图片尺寸
+     * @return 命中的图片，未命中时为空
+     */
+    QImage findOriginal(const QString &sourceKey, const QSize &minimumSize, QSize *sourceSize = nullptr);
+
+    /**
+     * @brief 插入原图（已有更大的缓存时忽略）
+     * @param sourceKey 原图缓存键
+     * @param image 解码结果
+     * @param sourceSize 原始图片尺寸
+     */
+    void insertOriginal(const QString &sourceKey, const QImage &image, const QSize &sourceSize);
+
+    // ========== 缩放图 ==========
+
+    /**
+     * @brief 查找缩放结果（仅 GUI 线程）
+     * @return 命中的图片（已设置设备像素比，与缓存共享像素数据），未命中时为空
+     */
+    QPixmap findScaled(const QString &scaledKey);
+
+    /**
+     * @brief 插入缩放结果（仅 GUI 线程，插入前先设置好设备像素比，之后修改会导致深拷贝）
+     */
+    void insertScaled(const QString &scaledKey, const QPixmap &pixmap);
+
+    /**
+     * @brief 移除原图及其所有缩放结果（控件释放缓冲区时调用，仍在使用这些图片的控件不受影响）
+     * @param sourceKey 原图缓存键
+     */
+    void release(const QString &sourceKey);
+
+    // ========== 预算与统计 ==========
+
+    /**
+     * @brief 设置字节预算（默认 256 MB，0 表示禁用缓存）
+     */
+    void setBudget(qint64 bytes);
+
+    /**
+     * @brief 获取字节预算
+     */
+    [[nodiscard]] qint64 getBudget() const;
+
+    /**
+     * @brief 是否启用缓存（预算大于 0）
+     */
+    [[nodiscard]] bool isEnabled() const { return getBudget() > 0; }
+
+    /**
+     * @brief 清空所有缓存（不重置统计；在工作线程中调用时保留缩放图）
+     */
+    void clear();
+
+    /**
+     * @brief 获取统计信息
+     */
+    [[nodiscard]] ImageCacheStats getStats() const;
+
+    /**
+     * @brief 重置命中/未命中/淘汰计数
+     */
+    void resetStats();
+
+private:
+    ImageCache();
+
+    ~ImageCache();
+
+    struct Private;
+    std::unique_ptr<Private> _d;
+};
+
+} // namespace Mel
+
+#endif // MEL_IMAGECACHE_H
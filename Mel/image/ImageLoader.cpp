@@ -0,0 +1,166 @@
+/**
+ * @file ImageLoader.cpp
+ * @brief 图片解码工具实现
+ */
+
+#include "ImageLoader.h"
+#include "ImageCache.h"
+#include "core/BackgroundTask.h"
+#include "PixelContainer.h"
+#include "core/ResourceBundle.h"
+#include "core/Stats.h"
+#include <QImageReader>
+#include <QPixmap>
+#include <QThread>
+#include <QThreadPool>
+
+namespace Mel {
+
+QImage ImageLoader::load(const QString &path, QString *errorString) {
+    return load(path, QSize(), Qt::IgnoreAspectRatio, nullptr, errorString);
+}
+
+QImage ImageLoader::load(const QString &path, const QSize &boundingSize, const Qt::AspectRatioMode aspectMode, QSize *sourceSize, QString *errorString) {
+    // 内置壁纸以外部资源包提供时，第一次访问时才注册
+    ResourceBundle::ensureLoadedFor(path);
+
+    // 构建时预先转换的像素容器：直接映射所需的级别，不需要解码
+    const QString containerPath = PixelContainer::locate(path);
+    if (!containerPath.isEmpty()) {
+        PixelContainer container;
+        if (container.open(containerPath)) {
+            const QImage image = container.levelFor(decodeSize(container.getSourceSize(), boundingSize, aspectMode));
+            if (!image.isNull()) {
+                if (sourceSize) {
+                    *sourceSize = container.getSourceSize();
+                }
+                return image;
+            }
+        }
+    }
+
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    // 读取文件头即可获得原始尺寸，不需要解码像素
+    QSize fullSize = reader.size();
+
+    // 带 EXIF 旋转的图片，解码后宽高互换
+    if (fullSize.isValid() && reader.transformation().testFlag(QImageIOHandler::TransformationRotate90)) {
+        fullSize.transpose();
+    }
+
+    const QSize requiredSize = fullSize.isValid() ? decodeSize(fullSize, boundingSize, aspectMode) : QSize();
+
+    // 优先使用进程级缓存（其他控件或之前的切换可能已经解码过）
+    ImageCache   &cache = ImageCache::instance();
+    const QString key   = cache.isEnabled() ? cache.sourceKey(path) : QString();
+    if (!key.isEmpty()) {
+        QSize        cachedSourceSize;
+        const QImage cached = cache.findOriginal(key, requiredSize, &cachedSourceSize);
+        if (!cached.isNull()) {
+            if (sourceSize) {
+                *sourceSize = cachedSourceSize;
+            }
+            return cached;
+        }
+    }
+
+    // 让解码器直接输出目标尺寸（qjpeg 会利用 libjpeg 的 DCT 缩放）
+    if (fullSize.isValid() && !boundingSize.isEmpty()) {
+        QSize scaledSize = requiredSize;
+        if (scaledSize != fullSize) {
+            // setScaledSize 作用于旋转前的图像
+            if (reader.transformation().testFlag(QImageIOHandler::TransformationRotate90)) {
+                scaledSize.transpose();
+            }
+            reader.setScaledSize(scaledSize);
+        }
+    }
+
+    QImage image;
+    {
+        StatsTimer timer(Histogram_DecodeTime);
+        image = reader.read();
+    }
+    StatsScope::current()->add(Counter_Decodes);
+    if (image.isNull()) {
+        if (errorString) {
+            *errorString = reader.errorString();
+        }
+        return {};
+    }
+
+    const QImage result = toDisplayFormat(image);
+    cache.insertOriginal(key, result, fullSize.isValid() ? fullSize : image.size());
+
+    if (sourceSize) {
+        *sourceSize = fullSize.isValid() ? fullSize : image.size();
+    }
+    return result;
+}
+
+void ImageLoader::loadAsync(const QString &path, const QSize &boundingSize, const Qt::AspectRatioMode aspectMode, QObject *receiver, Callback callback) {
+    struct Result {
+        QImage  image;
+        QSize   sourceSize;
+        QString errorString;
+    };
+
+    runInBackground(
+            threadPool(), receiver,
+            [path, boundingSize, aspectMode, stats = StatsScope::currentShared()]() {
+                // 解码耗时计入发起加载的控件
+                StatsScope scope(stats);
+                Result     result;
+                result.image = load(path, boundingSize, aspectMode, &result.sourceSize, &result.errorString);
+                return result;
+            },
+            [callback = std::move(callback)](const Result &result) { callback(result.image, result.sourceSize, result.errorString); });
+}
+
+QSize ImageLoader::decodeSize(const QSize &sourceSize, const QSize &boundingSize, const Qt::AspectRatioMode aspectMode) {
+    if (boundingSize.isEmpty() || sourceSize.isEmpty()) {
+        return sourceSize;
+    }
+
+    // 按比例适配目标尺寸，但不放大
+    const QSize scaled = sourceSize.scaled(boundingSize, aspectMode);
+    if (scaled.width() >= sourceSize.width() || scaled.height() >= sourceSize.height()) {
+        return sourceSize;
+    }
+    return scaled.expandedTo(QSize(1, 1));
+}
+
+QImage ImageLoader::toDisplayFormat(const QImage &image) {
+    if (image.isNull()) {
+        return image;
+    }
+
+    // 预乘格式可直接用于光栅绘制，避免每次 drawPixmap 时再转换
+    const QImage::Format format = image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+    if (image.format() == format) {
+        return image;
+    }
+    return image.convertToFormat(format);
+}
+
+qint64 ImageLoader::pixmapBytes(const QPixmap &pixmap) {
+    if (pixmap.isNull()) {
+        return 0;
+    }
+    const qint64 bytesPerLine = (static_cast<qint64>(pixmap.width()) * pixmap.depth() + 31) / 32 * 4;
+    return bytesPerLine * pixmap.height();
+}
+
+QThreadPool *ImageLoader::threadPool() {
+    // 独立线程池，避免占满全局线程池；解码以 IO 和内存带宽为主，两个线程足够
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool();
+        p->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 2));
+        return p;
+    }();
+    return pool;
+}
+
+} // namespace Mel
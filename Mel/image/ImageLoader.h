@@ -0,0 +1,100 @@
+/**
+ * @file ImageLoader.h
+ * @brief 图片解码工具 - 支持同步解码和后台线程池异步解码
+ */
+
+#ifndef MEL_IMAGELOADER_H
+#define MEL_IMAGELOADER_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QString>
+#include <functional>
+
+class QObject;
+class QPixmap;
+class QThreadPool;
+
+namespace Mel {
+
+/**
+ * @brief 图片解码工具
+ *
+ * 功能：
+ * - 使用 QImageReader 将图片解码为 QImage（可在任意线程调用）
+ * - 支持解码时直接缩小到目标尺寸（JPEG 可在 DCT 域缩放，避免解码完整原图）
+ * - 解码结果统一转换为适合绘制的格式（RGB32 / ARGB32_Premultiplied）
+ * - 解码前查询进程级 ImageCache，解码结果写回缓存
+ * - 在独立线程池中异步解码，并将结果投递回主线程
+ * - 访问内置壁纸（:/Mel/）时按需注册外部资源包（ResourceBundle）
+ * - 存在构建时预先转换的像素容器（PixelContainer）时直接映射，跳过解码
+ */
+class MEL_EXPORT ImageLoader {
+public:
+    /**
+     * @brief 异步解码完成回调
+     * @param image 解码结果（失败时为空）
+     * @param sourceSize 原始图片尺寸（未缩小前）
+     * @param errorString 错误信息（成功时为空）
+     */
+    using Callback = std::function<void(const QImage &image, const QSize &sourceSize, const QString &errorString)>;
+
+    /**
+     * @brief 同步解码图片
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @param errorString 可选，失败时写入错误信息
+     * @return 解码后的图片（失败时为空）
+     */
+    static QImage load(const QString &path, QString *errorString = nullptr);
+
+    /**
+     * @brief 同步解码图片，并在解码时缩小到目标尺寸
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @param boundingSize 目标尺寸（为空时按原尺寸解码；不会放大）
+     * @param aspectMode 原图按比例适配目标尺寸的方式
+     * @param sourceSize 可选，写入原始图片尺寸
+     * @param errorString 可选，失败时写入错误信息
+     * @return 解码后的图片（失败时为空）
+     */
+    static QImage load(const QString &path, const QSize &boundingSize, Qt::AspectRatioMode aspectMode, QSize *sourceSize = nullptr, QString *errorString = nullptr);
+
+    /**
+     * @brief 在后台线程池中异步解码图片
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @param boundingSize 目标尺寸（为空时按原尺寸解码；不会放大）
+     * @param aspectMode 原图按比例适配目标尺寸的方式
+     * @param receiver 接收者（必须位于主线程），销毁后回调不再执行
+     * @param callback 解码完成后在主线程中调用
+     */
+    static void loadAsync(const QString &path, const QSize &boundingSize, Qt::AspectRatioMode aspectMode, QObject *receiver, Callback callback);
+
+    /**
+     * @brief 计算解码尺寸
+     * @param sourceSize 原始图片尺寸
+     * @param boundingSize 目标尺寸（为空时返回原始尺寸）
+     * @param aspectMode 原图按比例适配目标尺寸的方式
+     * @return 解码尺寸（不超过原始尺寸）
+     */
+    static QSize decodeSize(const QSize &sourceSize, const QSize &boundingSize, Qt::AspectRatioMode aspectMode);
+
+    /**
+     * @brief 将图片转换为适合绘制的格式（RGB32 或 ARGB32_Premultiplied）
+     */
+    static QImage toDisplayFormat(const QImage &image);
+
+    /**
+     * @brief 计算 QPixmap 像素缓冲区占用的字节数（与 toImage().sizeInBytes() 一致，不转换图片）
+     *
+     * 按物理像素（已包含设备像素比）计算，每行与 QImage 相同按 4 字节对齐
+     */
+    static qint64 pixmapBytes(const QPixmap &pixmap);
+
+    /**
+     * @brief 图片解码专用线程池
+     */
+    static QThreadPool *threadPool();
+};
+
+} // namespace Mel
+
+#endif // MEL_IMAGELOADER_H
@@ -0,0 +1,131 @@
+/**
+ * @file ImagePreview.cpp
+ * @brief 图片预览实现
+ */
+
+#include "ImagePreview.h"
+#include "DiskCache.h"
+#include "PixelContainer.h"
+#include "Resampler.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace Mel {
+
+namespace {
+
+constexpr int MaxStoredPreviews = 256; // 进程内保存的预览数量上限（超出时清空）
+
+/**
+ * @brief 进程内保存的运行时预览
+ */
+struct PreviewStore {
+    QMutex                 mutex;
+    QHash<QString, QImage> previews; // 预览键 -> 预览
+};
+
+PreviewStore &previewStore() {
+    static PreviewStore store;
+    return store;
+}
+
+/**
+ * @brief 计算预览键（路径 + 大小 + 修改时间，不读取文件内容）
+ */
+QString previewKey(const QString &path) {
+    const QFileInfo info(path);
+    if (!info.exists()) {
+        return {};
+    }
+    return QStringLiteral("preview|%1|%2|%3").arg(info.absoluteFilePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+/**
+ * @brief 查找预转换容器末尾的预览级别
+ */
+QImage findContainerPreview(const QString &path) {
+    const QString containerPath = PixelContainer::locate(path);
+    if (containerPath.isEmpty()) {
+        return {};
+    }
+
+    PixelContainer container;
+    if (!container.open(containerPath) || container.levelCount() < 2) {
+        return {};
+    }
+    const int   last = container.levelCount() - 1;
+    const QSize size = container.levelSize(last);
+    if (size.width() > ImagePreview::MaxSize || size.height() > ImagePreview::MaxSize) {
+        return {};
+    }
+
+    // 复制出来，不让几 KB 的预览一直持有整个容器的映射
+    return container.level(last).copy();
+}
+
+} // namespace
+
+QImage ImagePreview::generate(const QImage &image, const int size) {
+    if (image.isNull() || size <= 0) {
+        return {};
+    }
+
+    const QSize previewSize = image.size().scaled(QSize(size, size), Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+    if (previewSize.width() >= image.width() && previewSize.height() >= image.height()) {
+        return image;
+    }
+    return Resampler::scale(image, previewSize, ScaleQuality_Area);
+}
+
+QImage ImagePreview::find(const QString &path) {
+    QImage preview = findContainerPreview(path);
+    if (!preview.isNull()) {
+        return preview;
+    }
+
+    const QString key = previewKey(path);
+    if (key.isEmpty()) {
+        return {};
+    }
+
+    PreviewStore &store = previewStore();
+    {
+        QMutexLocker locker(&store.mutex);
+        const auto   it = store.previews.constFind(key);
+        if (it != store.previews.constEnd()) {
+            return it.value();
+        }
+    }
+
+    // 之前的进程保存的预览（未启用磁盘缓存时为空）
+    preview = DiskCache::instance().findScaled(key);
+    if (!preview.isNull()) {
+        preview = preview.copy();
+        QMutexLocker locker(&store.mutex);
+        store.previews.insert(key, preview);
+    }
+    return preview;
+}
+
+void ImagePreview::store(const QString &path, const QImage &preview) {
+    const QString key = previewKey(path);
+    if (key.isEmpty() || preview.isNull()) {
+        return;
+    }
+
+    {
+        PreviewStore &store = previewStore();
+        QMutexLocker  locker(&store.mutex);
+        if (store.previews.size() >= MaxStoredPreviews) {
+            store.previews.clear();
+        }
+        store.previews.insert(key, preview);
+    }
+
+    DiskCache::instance().insertScaled(key, preview, preview.size());
+}
+
+} // namespace Mel
@@ -0,0 +1,66 @@
+/**
+ * @file ImagePreview.h
+ * @brief 图片预览 - 完整图片解码完成之前先拉伸显示的极小缩略图
+ */
+
+#ifndef MEL_IMAGEPREVIEW_H
+#define MEL_IMAGEPREVIEW_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QString>
+
+namespace Mel {
+
+/**
+ * @brief 极小预览图（如 32x18）的生成与查找（线程安全）
+ *
+ * 预览只有几 KB，拉伸绘制时天然模糊，用于渐进加载时的第一帧。来源：
+ * - 构建时：Mel_transcode 的 --preview 选项在像素容器末尾追加一级预览（内置壁纸）
+ * - 运行时：解码完成后由 generate 生成并 store，保存在进程内，启用 DiskCache 时同时写入磁盘供下次启动使用
+ *
+ * 查找只读取像素容器的文件头或极小的缓存文件，不读取和解码原图
+ */
+class MEL_EXPORT ImagePreview {
+public:
+    /**
+     * @brief 默认预览尺寸（最长边像素）
+     */
+    static constexpr int DefaultSize = 32;
+
+    /**
+     * @brief 像素容器中不超过该尺寸（最长边像素）的最后一级视为预览
+     */
+    static constexpr int MaxSize = 64;
+
+    /**
+     * @brief 生成预览（按比例缩小到最长边不超过 size）
+     * @param image 完整图片（或任意不小于预览的缩小版本）
+     * @param size 最长边像素
+     */
+    static QImage generate(const QImage &image, int size = DefaultSize);
+
+    /**
+     * @brief 查找图片的预览
+     *
+     * 依次查找预转换容器中的预览级别、进程内保存的预览、磁盘缓存（启用时）
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @return 预览图片，没有时为空
+     */
+    static QImage find(const QString &path);
+
+    /**
+     * @brief 保存运行时生成的预览
+     *
+     * 启用 DiskCache 时包含文件 IO，应在后台线程调用
+     * @param path 图片路径（以路径、文件大小和修改时间区分版本）
+     * @param preview generate 的结果
+     */
+    static void store(const QString &path, const QImage &preview);
+
+    ImagePreview() = delete;
+};
+
+} // namespace Mel
+
+#endif // MEL_IMAGEPREVIEW_H
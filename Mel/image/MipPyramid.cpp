@@ -0,0 +1,77 @@
+/**
+ * @file MipPyramid.cpp
+ * @brief 图片金字塔实现
+ */
+
+#include "MipPyramid.h"
+#include "ImageLoader.h"
+
+namespace Mel {
+
+MipPyramid::MipPyramid(const QImage &image, const int minimumSize) {
+    if (image.isNull()) {
+        return;
+    }
+
+    _levels.append(image);
+    while (_levels.last().width() / 2 >= minimumSize && _levels.last().height() / 2 >= minimumSize) {
+        _levels.append(downsample2x(_levels.last()));
+    }
+}
+
+QImage MipPyramid::levelFor(const QSize &targetSize) const {
+    if (_levels.isEmpty()) {
+        return {};
+    }
+
+    // 从最小一级向上找第一个能覆盖目标尺寸的级别
+    for (int i = _levels.size() - 1; i > 0; --i) {
+        const QImage &candidate = _levels.at(i);
+        if (candidate.width() >= targetSize.width() && candidate.height() >= targetSize.height()) {
+            return candidate;
+        }
+    }
+    return _levels.first();
+}
+
+qint64 MipPyramid::memoryBytes() const {
+    qint64 bytes = 0;
+    for (int i = 1; i < _levels.size(); ++i) {
+        bytes += static_cast<qint64>(_levels.at(i).sizeInBytes());
+    }
+    return bytes;
+}
+
+QImage MipPyramid::downsample2x(const QImage &image) {
+    const QImage source = ImageLoader::toDisplayFormat(image);
+    const int    width  = source.width() / 2;
+    const int    height = source.height() / 2;
+    if (width <= 0 || height <= 0) {
+        return {};
+    }
+
+    QImage result(width, height, source.format());
+
+    // 每个 32 位像素拆成 R_B 和 A_G 两组，每组两个通道各占 16 位，4 个像素相加不会溢出
+    for (int y = 0; y < height; ++y) {
+        const auto *row0 = reinterpret_cast<const quint32 *>(source.constScanLine(y * 2));
+        const auto *row1 = reinterpret_cast<const quint32 *>(source.constScanLine(y * 2 + 1));
+        auto       *out  = reinterpret_cast<quint32 *>(result.scanLine(y));
+
+        for (int x = 0; x < width; ++x) {
+            const quint32 p0 = row0[x * 2];
+            const quint32 p1 = row0[x * 2 + 1];
+            const quint32 p2 = row1[x * 2];
+            const quint32 p3 = row1[x * 2 + 1];
+
+            const quint32 rb = (p0 & 0x00FF00FFu) + (p1 & 0x00FF00FFu) + (p2 & 0x00FF00FFu) + (p3 & 0x00FF00FFu) + 0x00020002u;
+            const quint32 ag = ((p0 >> 8) & 0x00FF00FFu) + ((p1 >> 8) & 0x00FF00FFu) + ((p2 >> 8) & 0x00FF00FFu) + ((p3 >> 8) & 0x00FF00FFu) + 0x00020002u;
+
+            out[x] = ((rb >> 2) & 0x00FF00FFu) | (((ag >> 2) & 0x00FF00FFu) << 8);
+        }
+    }
+
+    return result;
+}
+
+} // namespace Mel
@@ -0,0 +1,72 @@
+/**
+ * @file MipPyramid.h
+ * @brief 图片金字塔（Mipmap）- 预先生成 1/2、1/4 ... 的缩小版本，加速高质量缩放
+ */
+
+#ifndef MEL_MIPPYRAMID_H
+#define MEL_MIPPYRAMID_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QVector>
+
+namespace Mel {
+
+/**
+ * @brief 图片金字塔
+ *
+ * 第 0 级为原图（与原图共享数据），之后每一级宽高各减半（2x2 盒式滤波）。
+ * 缩放时从不小于目标尺寸的最小一级开始，平滑缩放只需处理很少的像素。
+ * 构建过程只读原图，可在任意线程执行
+ */
+class MEL_EXPORT MipPyramid {
+public:
+    MipPyramid() = default;
+
+    /**
+     * @brief 构建图片金字塔
+     * @param image 原图（第 0 级）
+     * @param minimumSize 最小一级的边长下限（像素）
+     */
+    explicit MipPyramid(const QImage &image, int minimumSize = 16);
+
+    /**
+     * @brief 是否为空
+     */
+    [[nodiscard]] bool isNull() const { return _levels.isEmpty(); }
+
+    /**
+     * @brief 级数（包含第 0 级）
+     */
+    [[nodiscard]] int levelCount() const { return _levels.size(); }
+
+    /**
+     * @brief 获取指定级别
+     */
+    [[nodiscard]] QImage level(int index) const { return _levels.value(index); }
+
+    /**
+     * @brief 获取不小于目标尺寸的最小一级
+     * @param targetSize 目标尺寸
+     * @return 对应级别（目标尺寸大于原图时返回原图）
+     */
+    [[nodiscard]] QImage levelFor(const QSize &targetSize) const;
+
+    /**
+     * @brief 金字塔额外占用的字节数（不含与原图共享的第 0 级）
+     */
+    [[nodiscard]] qint64 memoryBytes() const;
+
+    /**
+     * @brief 将图片宽高各缩小一半（2x2 盒式滤波）
+     * @param image 源图片（RGB32 / ARGB32_Premultiplied 以外的格式会先转换）
+     */
+    static QImage downsample2x(const QImage &image);
+
+private:
+    QVector<QImage> _levels; // 各级图片，第 0 级为原图
+};
+
+} // namespace Mel
+
+#endif // MEL_MIPPYRAMID_H
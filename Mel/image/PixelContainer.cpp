@@ -0,0 +1,319 @@
+/**
+ * @file PixelContainer.cpp
+ * @brief 像素容器实现
+ */
+
+#include "PixelContainer.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QSet>
+#include <cstring>
+#include <limits>
+
+namespace Mel {
+
+namespace {
+
+constexpr char    kMagic[8]  = {'M', 'E', 'L', 'P', 'I', 'X', '\0', '\0'};
+constexpr quint32 kVersion   = 1;
+constexpr quint32 kByteOrder = 0x01020304; // 按本机字节序写入，读取时不一致则拒绝
+constexpr qint64  kAlignment = 64;         // 像素数据对齐（便于 SIMD 访问）
+constexpr quint32 kMaxLevels = 16;
+constexpr quint32 kMaxSide   = 32768;      // 每级宽高上限，保证后续的乘法不会溢出
+
+/**
+ * @brief 文件头
+ */
+struct FileHeader {
+    char    magic[8];
+    quint32 version;
+    quint32 byteOrder;
+    quint32 levelCount;
+    quint32 sourceWidth;
+    quint32 sourceHeight;
+    quint32 reserved;
+};
+
+/**
+ * @brief 级别表项
+ */
+struct LevelEntry {
+    quint32 width;
+    quint32 height;
+    quint32 format;
+    quint32 bytesPerLine;
+    quint64 offset;
+    quint64 byteCount;
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader 布局不符");
+static_assert(sizeof(LevelEntry) == 32, "LevelEntry 布局不符");
+
+qint64 alignUp(const qint64 value) {
+    return (value + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/**
+ * @brief 没有对应容器的图片路径（每次加载都会查找，未找到的结果只探测一次文件系统）
+ */
+struct MissingPaths {
+    QMutex        mutex;
+    QSet<QString> paths;
+};
+
+MissingPaths &missingPaths() {
+    static MissingPaths instance;
+    return instance;
+}
+
+void setError(QString *errorString, const QString &message) {
+    if (errorString) {
+        *errorString = message;
+    }
+}
+
+/**
+ * @brief 映射的文件在最后一个引用它的 QImage 销毁时关闭
+ */
+void releaseFile(void *info) {
+    delete static_cast<std::shared_ptr<QFile> *>(info);
+}
+
+} // namespace
+
+QString PixelContainer::suffix() {
+    return QStringLiteral(".melpix");
+}
+
+bool PixelContainer::write(const QString &path, const QVector<QImage> &levels, const QSize &sourceSize, QString *errorString) {
+    if (levels.isEmpty() || levels.size() > static_cast<int>(kMaxLevels)) {
+        setError(errorString, QStringLiteral("级数无效: %1").arg(levels.size()));
+        return false;
+    }
+
+    // 统一为可直接绘制的格式
+    QVector<QImage> images;
+    for (const QImage &level : levels) {
+        if (level.isNull()) {
+            setError(errorString, QStringLiteral("存在空的级别"));
+            return false;
+        }
+        const QImage::Format format = level.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+        images.append(level.format() == format ? level : level.convertToFormat(format));
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version      = kVersion;
+    header.byteOrder    = kByteOrder;
+    header.levelCount   = static_cast<quint32>(images.size());
+    header.sourceWidth  = static_cast<quint32>(sourceSize.width());
+    header.sourceHeight = static_cast<quint32>(sourceSize.height());
+
+    QVector<LevelEntry> entries;
+    qint64              offset = alignUp(static_cast<qint64>(sizeof(FileHeader) + sizeof(LevelEntry) * images.size()));
+    for (const QImage &image : images) {
+        LevelEntry entry{};
+        entry.width        = static_cast<quint32>(image.width());
+        entry.height       = static_cast<quint32>(image.height());
+        entry.format       = static_cast<quint32>(image.format());
+        entry.bytesPerLine = static_cast<quint32>(image.width() * 4);
+        entry.offset       = static_cast<quint64>(offset);
+        entry.byteCount    = static_cast<quint64>(entry.bytesPerLine) * entry.height;
+        entries.append(entry);
+        offset = alignUp(offset + static_cast<qint64>(entry.byteCount));
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        setError(errorString, file.errorString());
+        return false;
+    }
+
+    auto padTo = [&file](const qint64 position) {
+        const QByteArray padding(static_cast<int>(position - file.pos()), '\0');
+        file.write(padding);
+    };
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(entries.constData()), static_cast<qint64>(sizeof(LevelEntry) * entries.size()));
+    for (int i = 0; i < images.size(); ++i) {
+        padTo(static_cast<qint64>(entries[i].offset));
+        // 逐行写入，去掉 QImage 的行尾填充
+        const QImage &image = images[i];
+        for (int y = 0; y < image.height(); ++y) {
+            file.write(reinterpret_cast<const char *>(image.constScanLine(y)), entries[i].bytesPerLine);
+        }
+    }
+
+    if (!file.commit()) {
+        setError(errorString, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QString PixelContainer::locate(const QString &imagePath) {
+    MissingPaths &missing = missingPaths();
+    {
+        QMutexLocker locker(&missing.mutex);
+        if (missing.paths.contains(imagePath)) {
+            return {};
+        }
+    }
+
+    QString found = findContainer(imagePath);
+    if (found.isEmpty()) {
+        QMutexLocker locker(&missing.mutex);
+        missing.paths.insert(imagePath);
+    }
+    return found;
+}
+
+QString PixelContainer::findContainer(const QString &imagePath) {
+    if (imagePath.startsWith(QLatin1String(":/"))) {
+        // 资源路径：在预转换目录中按资源路径查找（:/Mel/res/... → <目录>/Mel/res/....melpix）
+        const QString relative = imagePath.mid(2) + suffix();
+
+        QStringList directories;
+        const QString fromEnvironment = qEnvironmentVariable("MEL_PIXEL_DIR");
+        if (!fromEnvironment.isEmpty()) {
+            directories.append(fromEnvironment);
+        }
+        if (QCoreApplication::instance()) {
+            const QDir applicationDir(QCoreApplication::applicationDirPath());
+            directories.append(applicationDir.filePath(QStringLiteral("Mel_pixels")));
+            directories.append(applicationDir.filePath(QStringLiteral("../share/Mel/Mel_pixels")));
+        }
+
+        for (const QString &directory : directories) {
+            const QString candidate = QDir(directory).filePath(relative);
+            if (QFileInfo::exists(candidate)) {
+                return candidate;
+            }
+        }
+        return {};
+    }
+
+    // 普通文件：同目录下的容器，原图更新过时视为过期
+    const QFileInfo container(imagePath + suffix());
+    if (container.exists() && container.lastModified() >= QFileInfo(imagePath).lastModified()) {
+        return container.filePath();
+    }
+    return {};
+}
+
+PixelContainer::PixelContainer() :
+    _data(nullptr)
+{
+}
+
+PixelContainer::~PixelContainer() = default;
+
+bool PixelContainer::open(const QString &path, QString *errorString) {
+    _file.reset();
+    _data = nullptr;
+    _levels.clear();
+
+    auto file = std::make_shared<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        setError(errorString, file->errorString());
+        return false;
+    }
+
+    const qint64 fileSize = file->size();
+    if (fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+        setError(errorString, QStringLiteral("文件过小"));
+        return false;
+    }
+
+    const uchar *data = file->map(0, fileSize);
+    if (!data) {
+        setError(errorString, QStringLiteral("无法映射文件: %1").arg(file->errorString()));
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        setError(errorString, QStringLiteral("不是像素容器或版本不符"));
+        return false;
+    }
+    if (header.byteOrder != kByteOrder) {
+        setError(errorString, QStringLiteral("字节序不符"));
+        return false;
+    }
+    if (header.levelCount == 0 || header.levelCount > kMaxLevels || fileSize < static_cast<qint64>(sizeof(FileHeader) + sizeof(LevelEntry) * header.levelCount)) {
+        setError(errorString, QStringLiteral("级别表无效"));
+        return false;
+    }
+
+    QVector<Level> levels;
+    for (quint32 i = 0; i < header.levelCount; ++i) {
+        LevelEntry entry{};
+        std::memcpy(&entry, data + sizeof(FileHeader) + sizeof(LevelEntry) * i, sizeof(entry));
+
+        const bool validFormat = entry.format == QImage::Format_RGB32 || entry.format == QImage::Format_ARGB32_Premultiplied;
+        // 先限制宽高和行字节数，之后的乘法都在 64 位中进行；偏移先与剩余长度比较，避免相加溢出
+        const bool validSize = entry.width > 0 && entry.height > 0 && entry.width <= kMaxSide && entry.height <= kMaxSide
+                            && entry.bytesPerLine >= static_cast<quint64>(entry.width) * 4 && entry.bytesPerLine <= static_cast<quint32>(std::numeric_limits<int>::max())
+                            && entry.bytesPerLine % 4 == 0;
+        const bool inBounds = validSize && entry.offset % 4 == 0 && entry.byteCount >= static_cast<quint64>(entry.bytesPerLine) * entry.height
+                           && entry.byteCount <= static_cast<quint64>(fileSize) && entry.offset <= static_cast<quint64>(fileSize) - entry.byteCount;
+        if (!validFormat || !validSize || !inBounds) {
+            setError(errorString, QStringLiteral("第 %1 级数据无效").arg(i));
+            return false;
+        }
+
+        Level level;
+        level.size         = QSize(static_cast<int>(entry.width), static_cast<int>(entry.height));
+        level.format       = static_cast<QImage::Format>(entry.format);
+        level.bytesPerLine = entry.bytesPerLine;
+        level.offset       = static_cast<qint64>(entry.offset);
+        levels.append(level);
+    }
+
+    _file       = std::move(file);
+    _data       = data;
+    _sourceSize = QSize(static_cast<int>(header.sourceWidth), static_cast<int>(header.sourceHeight));
+    _levels     = levels;
+    return true;
+}
+
+QSize PixelContainer::levelSize(const int index) const {
+    return index >= 0 && index < _levels.size() ? _levels[index].size : QSize();
+}
+
+QImage PixelContainer::level(const int index) const {
+    if (!_data || index < 0 || index >= _levels.size()) {
+        return {};
+    }
+
+    // 只读引用映射的内存；QImage 持有文件的引用，被修改时才会复制
+    const Level &level = _levels[index];
+    return {_data + level.offset, level.size.width(), level.size.height(), static_cast<int>(level.bytesPerLine), level.format, releaseFile, new std::shared_ptr<QFile>(_file)};
+}
+
+QImage PixelContainer::levelFor(const QSize &requiredSize) const {
+    if (_levels.isEmpty()) {
+        return {};
+    }
+
+    int best = 0;
+    if (!requiredSize.isEmpty()) {
+        for (int i = 1; i < _levels.size(); ++i) {
+            const QSize size = _levels[i].size;
+            if (size.width() >= requiredSize.width() && size.height() >= requiredSize.height() && size.width() * size.height() < _levels[best].size.width() * _levels[best].size.height()) {
+                best = i;
+            }
+        }
+    }
+    return level(best);
+}
+
+} // namespace Mel
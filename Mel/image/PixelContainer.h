@@ -0,0 +1,122 @@
+/**
+ * @file PixelContainer.h
+ * @brief 像素容器 - 预先转换好的未压缩像素文件（含多级缩小版本），映射后直接作为 QImage 使用
+ */
+
+#ifndef MEL_PIXELCONTAINER_H
+#define MEL_PIXELCONTAINER_H
+
+#include "Mel_export.h"
+#include <QImage>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+class QFile;
+
+namespace Mel {
+
+/**
+ * @brief 像素容器（.melpix）
+ *
+ * 文件内容为文件头、级别表和按 64 字节对齐的像素数据。每一级都是可直接绘制的
+ * RGB32 / ARGB32_Premultiplied 像素（本机字节序），第 0 级为原图，之后是构建时预先缩小的版本（如 1080p、1440p）。
+ * 打开时通过 QFile::map 映射文件，level() 返回的 QImage 直接引用映射的内存，不需要解码，
+ * 也只有实际绘制的部分才会被换入内存。
+ *
+ * 容器由构建时的 Mel_transcode 工具生成（MEL_PRETRANSCODE_WALLPAPERS 选项），ImageLoader 找到容器时优先使用
+ */
+class MEL_EXPORT PixelContainer {
+public:
+    /**
+     * @brief 容器文件扩展名（追加在原图文件名之后，如 a.png.melpix）
+     */
+    static QString suffix();
+
+    /**
+     * @brief 写入容器文件
+     * @param path 容器文件路径
+     * @param levels 各级图片（第 0 级为原图，之后依次缩小；会转换为 RGB32 / ARGB32_Premultiplied）
+     * @param sourceSize 原始图片尺寸
+     * @param errorString 可选，失败时写入错误信息
+     * @return 是否成功
+     */
+    static bool write(const QString &path, const QVector<QImage> &levels, const QSize &sourceSize, QString *errorString = nullptr);
+
+    /**
+     * @brief 查找图片对应的容器文件
+     *
+     * 资源路径（:/）在预转换目录中查找：环境变量 MEL_PIXEL_DIR、可执行文件所在目录的 Mel_pixels、
+     * 可执行文件所在目录的 ../share/Mel/Mel_pixels；普通文件查找同目录下不早于原图的 原文件名.melpix。
+     * 未找到的结果按路径缓存在进程内，之后不再探测文件系统（进程运行期间新生成的容器不会被发现）
+     * @param imagePath 原图路径
+     * @return 容器文件路径（未找到时为空）
+     */
+    static QString locate(const QString &imagePath);
+
+    PixelContainer();
+
+    ~PixelContainer();
+
+    /**
+     * @brief 打开并映射容器文件
+     * @param path 容器文件路径
+     * @param errorString 可选，失败时写入错误信息
+     * @return 是否成功（文件不存在、格式不符或字节序不同时失败）
+     */
+    bool open(const QString &path, QString *errorString = nullptr);
+
+    /**
+     * @brief 是否已打开
+     */
+    [[nodiscard]] bool isOpen() const { return _data != nullptr; }
+
+    /**
+     * @brief 原始图片尺寸
+     */
+    [[nodiscard]] QSize getSourceSize() const { return _sourceSize; }
+
+    /**
+     * @brief 级数（包含第 0 级）
+     */
+    [[nodiscard]] int levelCount() const { return _levels.size(); }
+
+    /**
+     * @brief 获取指定级别的尺寸
+     */
+    [[nodiscard]] QSize levelSize(int index) const;
+
+    /**
+     * @brief 获取指定级别（引用映射的内存，容器关闭后仍然有效）
+     */
+    [[nodiscard]] QImage level(int index) const;
+
+    /**
+     * @brief 获取宽高都不小于目标尺寸的最小一级
+     * @param requiredSize 目标尺寸（为空时返回第 0 级）
+     * @return 对应级别（没有足够大的级别时返回第 0 级）
+     */
+    [[nodiscard]] QImage levelFor(const QSize &requiredSize) const;
+
+private:
+    struct Level {
+        QSize          size;
+        QImage::Format format       = QImage::Format_Invalid;
+        qint64         bytesPerLine = 0;
+        qint64         offset       = 0;
+    };
+
+    /**
+     * @brief 查找容器文件（不经过缓存，每次都探测文件系统）
+     */
+    static QString findContainer(const QString &imagePath);
+
+    std::shared_ptr<QFile> _file;       // 映射的文件（被返回的 QImage 共同持有）
+    const uchar           *_data;       // 映射的起始地址
+    QSize                  _sourceSize; // 原始图片尺寸
+    QVector<Level>         _levels;     // 级别表
+};
+
+} // namespace Mel
+
+#endif // MEL_PIXELCONTAINER_H
@@ -0,0 +1,517 @@
+/**
+ * @file Resampler.cpp
+ * @brief 图片重采样器实现
+ */
+
+#include "Resampler.h"
+#include "ImageLoader.h"
+#include "core/Parallel.h"
+#include "core/Simd.h"
+#include "core/Stats.h"
+#include <QThread>
+#include <QVarLengthArray>
+#include <QVector>
+#include <QtMath>
+
+namespace Mel {
+
+namespace {
+
+constexpr int PrecisionBits    = 14;                        // 定点权重精度
+constexpr int Rounding         = 1 << (PrecisionBits - 1); // 四舍五入偏移
+constexpr int MinRowsPerThread = 32;                        // 每个线程至少处理的行数
+
+// ========== 滤波权重 ==========
+
+/**
+ * @brief 一维方向上每个输出像素的滤波抽头
+ */
+struct Contributions {
+    int             maxTaps = 0; // 每个输出像素的最大抽头数
+    QVector<int>    start;       // 起始源坐标
+    QVector<int>    count;       // 有效抽头数
+    QVector<qint16> weights;     // 定点权重（每个输出像素 maxTaps 个，总和为 1 << PrecisionBits）
+
+    [[nodiscard]] const qint16 *weightsFor(const int index) const { return weights.constData() + index * maxTaps; }
+};
+
+double triangleKernel(const double x) {
+    const double ax = qAbs(x);
+    return ax < 1.0 ? 1.0 - ax : 0.0;
+}
+
+double sinc(const double x) {
+    if (x == 0.0) {
+        return 1.0;
+    }
+    const double px = M_PI * x;
+    return qSin(px) / px;
+}
+
+double lanczos3Kernel(const double x) {
+    return qAbs(x) < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+}
+
+Contributions computeContributions(const int srcLength, const int dstLength, const ScaleQuality quality) {
+    const double scale       = static_cast<double>(dstLength) / srcLength;
+    const bool   downscale   = scale < 1.0;
+    const double filterScale = downscale ? 1.0 / scale : 1.0;
+
+    // 区域平均只在缩小时按覆盖面积计算，放大时退化为双线性
+    const bool area   = quality == ScaleQuality_Area && downscale;
+    double     radius = 1.0;
+    if (quality == ScaleQuality_Lanczos3) {
+        radius = 3.0;
+    } else if (area) {
+        radius = 0.5;
+    }
+
+    const double support = radius * filterScale;
+
+    Contributions c;
+    c.maxTaps = qCeil(support * 2.0) + 2;
+    c.start.resize(dstLength);
+    c.count.resize(dstLength);
+    c.weights.fill(0, dstLength * c.maxTaps);
+
+    QVarLengthArray<double, 64> raw(c.maxTaps);
+    for (int i = 0; i < dstLength; ++i) {
+        const double center = (i + 0.5) / scale;
+        const int    left   = qMax(0, qFloor(center - support));
+        const int    right  = qMin(srcLength, qCeil(center + support));
+
+        double sum = 0.0;
+        int    n   = 0;
+        for (int j = left; j < right && n < c.maxTaps; ++j, ++n) {
+            double weight;
+            if (area) {
+                // 源像素 [j, j+1) 与输出像素覆盖区间的重叠长度
+                weight = qMax(0.0, qMin(j + 1.0, center + support) - qMax(static_cast<double>(j), center - support));
+            } else if (quality == ScaleQuality_Lanczos3) {
+                weight = lanczos3Kernel((j + 0.5 - center) / filterScale);
+            } else {
+                weight = triangleKernel((j + 0.5 - center) / filterScale);
+            }
+            raw[n] = weight;
+            sum += weight;
+        }
+
+        qint16 *fixed = c.weights.data() + i * c.maxTaps;
+        if (n == 0 || sum == 0.0) {
+            // 退化情况：取最近的源像素
+            c.start[i] = qBound(0, static_cast<int>(center), srcLength - 1);
+            c.count[i] = 1;
+            fixed[0]   = 1 << PrecisionBits;
+            continue;
+        }
+
+        // 归一化并量化为定点数，误差补到最大的权重上，保证总和精确为 1
+        int total   = 0;
+        int largest = 0;
+        for (int k = 0; k < n; ++k) {
+            fixed[k] = static_cast<qint16>(qRound(raw[k] / sum * (1 << PrecisionBits)));
+            total += fixed[k];
+            if (fixed[k] > fixed[largest]) {
+                largest = k;
+            }
+        }
+        fixed[largest] = static_cast<qint16>(fixed[largest] + ((1 << PrecisionBits) - total));
+
+        // 去掉两端权重为 0 的抽头
+        int first = 0;
+        int last  = n - 1;
+        while (first < last && fixed[first] == 0) ++first;
+        while (last > first && fixed[last] == 0) --last;
+        if (first > 0) {
+            for (int k = first; k <= last; ++k) {
+                fixed[k - first] = fixed[k];
+            }
+            for (int k = last - first + 1; k < n; ++k) {
+                fixed[k] = 0;
+            }
+        }
+        c.start[i] = left + first;
+        c.count[i] = last - first + 1;
+    }
+
+    return c;
+}
+
+// ========== 标量内核（参考实现） ==========
+
+inline quint32 packChannels(const int *acc) {
+    quint32 pixel = 0;
+    for (int ch = 0; ch < 4; ++ch) {
+        pixel |= static_cast<quint32>(qBound(0, acc[ch] >> PrecisionBits, 255)) << (ch * 8);
+    }
+    return pixel;
+}
+
+void horizontalScalar(const quint32 *src, quint32 *dst, const int dstWidth, const Contributions &c) {
+    for (int x = 0; x < dstWidth; ++x) {
+        const quint32 *p = src + c.start[x];
+        const qint16  *w = c.weightsFor(x);
+        int            acc[4] = {Rounding, Rounding, Rounding, Rounding};
+        for (int k = 0; k < c.count[x]; ++k) {
+            const quint32 pixel = p[k];
+            for (int ch = 0; ch < 4; ++ch) {
+                acc[ch] += static_cast<int>((pixel >> (ch * 8)) & 0xFF) * w[k];
+            }
+        }
+        dst[x] = packChannels(acc);
+    }
+}
+
+void verticalScalar(const quint32 *const *rows, const qint16 *w, const int taps, quint32 *dst, const int begin, const int end) {
+    for (int x = begin; x < end; ++x) {
+        int acc[4] = {Rounding, Rounding, Rounding, Rounding};
+        for (int k = 0; k < taps; ++k) {
+            const quint32 pixel = rows[k][x];
+            for (int ch = 0; ch < 4; ++ch) {
+                acc[ch] += static_cast<int>((pixel >> (ch * 8)) & 0xFF) * w[k];
+            }
+        }
+        dst[x] = packChannels(acc);
+    }
+}
+
+void verticalScalarRow(const quint32 *const *rows, const qint16 *w, const int taps, quint32 *dst, const int width) {
+    verticalScalar(rows, w, taps, dst, 0, width);
+}
+
+// ========== SIMD 内核 ==========
+
+#ifdef MEL_SIMD_X86
+
+/**
+ * @brief 把两个权重打包成 madd 使用的 int16 对（低位对应第一个抽头）
+ */
+inline int pairWeights(const qint16 w0, const qint16 w1) {
+    return static_cast<int>((static_cast<quint32>(static_cast<quint16>(w1)) << 16) | static_cast<quint16>(w0));
+}
+
+MEL_TARGET_SSE2 void horizontalSse2(const quint32 *src, quint32 *dst, const int dstWidth, const Contributions &c) {
+    const __m128i zero = _mm_setzero_si128();
+    for (int x = 0; x < dstWidth; ++x) {
+        const quint32 *p   = src + c.start[x];
+        const qint16  *w   = c.weightsFor(x);
+        const int      n   = c.count[x];
+        __m128i        acc = _mm_set1_epi32(Rounding);
+
+        int k = 0;
+        for (; k + 1 < n; k += 2) {
+            // 两个像素交错排列：p0c0 p1c0 p0c1 p1c1 ...，madd 一次完成两个抽头
+            __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + k)), zero);
+            pixels         = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+            acc            = _mm_add_epi32(acc, _mm_madd_epi16(pixels, _mm_set1_epi32(pairWeights(w[k], w[k + 1]))));
+        }
+        if (k < n) {
+            __m128i pixel = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(p[k])), zero);
+            pixel         = _mm_unpacklo_epi16(pixel, zero);
+            acc           = _mm_add_epi32(acc, _mm_madd_epi16(pixel, _mm_set1_epi32(pairWeights(w[k], 0))));
+        }
+
+        acc    = _mm_srai_epi32(acc, PrecisionBits);
+        acc    = _mm_packs_epi32(acc, acc);
+        acc    = _mm_packus_epi16(acc, acc);
+        dst[x] = static_cast<quint32>(_mm_cvtsi128_si32(acc));
+    }
+}
+
+MEL_TARGET_SSE2 void verticalSse2(const quint32 *const *rows, const qint16 *w, const int taps, quint32 *dst, const int width) {
+    const __m128i zero = _mm_setzero_si128();
+
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        __m128i acc0 = _mm_set1_epi32(Rounding);
+        __m128i acc1 = acc0;
+        __m128i acc2 = acc0;
+        __m128i acc3 = acc0;
+
+        for (int k = 0; k < taps; k += 2) {
+            // 两行交错排列，madd 一次完成两个抽头；奇数抽头时第二行取 0
+            const __m128i a       = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + x));
+            const __m128i b       = k + 1 < taps ? _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k + 1] + x)) : zero;
+            const __m128i weights = _mm_set1_epi32(pairWeights(w[k], k + 1 < taps ? w[k + 1] : 0));
+
+            const __m128i aLo = _mm_unpacklo_epi8(a, zero);
+            const __m128i aHi = _mm_unpackhi_epi8(a, zero);
+            const __m128i bLo = _mm_unpacklo_epi8(b, zero);
+            const __m128i bHi = _mm_unpackhi_epi8(b, zero);
+
+            acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(_mm_unpacklo_epi16(aLo, bLo), weights));
+            acc1 = _mm_add_epi32(acc1, _mm_madd_epi16(_mm_unpackhi_epi16(aLo, bLo), weights));
+            acc2 = _mm_add_epi32(acc2, _mm_madd_epi16(_mm_unpacklo_epi16(aHi, bHi), weights));
+            acc3 = _mm_add_epi32(acc3, _mm_madd_epi16(_mm_unpackhi_epi16(aHi, bHi), weights));
+        }
+
+        const __m128i p01 = _mm_packs_epi32(_mm_srai_epi32(acc0, PrecisionBits), _mm_srai_epi32(acc1, PrecisionBits));
+        const __m128i p23 = _mm_packs_epi32(_mm_srai_epi32(acc2, PrecisionBits), _mm_srai_epi32(acc3, PrecisionBits));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_packus_epi16(p01, p23));
+    }
+
+    verticalScalar(rows, w, taps, dst, x, width);
+}
+
+MEL_TARGET_AVX2 void horizontalAvx2(const quint32 *src, quint32 *dst, const int dstWidth, const Contributions &c) {
+    const __m128i zero = _mm_setzero_si128();
+    for (int x = 0; x < dstWidth; ++x) {
+        const quint32 *p = src + c.start[x];
+        const qint16  *w = c.weightsFor(x);
+        const int      n = c.count[x];
+
+        // 每次处理 4 个抽头：低 128 位为抽头 0/1，高 128 位为抽头 2/3
+        __m256i acc8 = _mm256_setzero_si256();
+        int     k    = 0;
+        for (; k + 3 < n; k += 4) {
+            __m256i pixels        = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + k)));
+            pixels                = _mm256_unpacklo_epi16(pixels, _mm256_srli_si256(pixels, 8));
+            const int     w01     = pairWeights(w[k], w[k + 1]);
+            const int     w23     = pairWeights(w[k + 2], w[k + 3]);
+            const __m256i weights = _mm256_setr_epi32(w01, w01, w01, w01, w23, w23, w23, w23);
+            acc8                  = _mm256_add_epi32(acc8, _mm256_madd_epi16(pixels, weights));
+        }
+
+        __m128i acc = _mm_add_epi32(_mm_set1_epi32(Rounding), _mm_add_epi32(_mm256_castsi256_si128(acc8), _mm256_extracti128_si256(acc8, 1)));
+        for (; k + 1 < n; k += 2) {
+            __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + k)), zero);
+            pixels         = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+            acc            = _mm_add_epi32(acc, _mm_madd_epi16(pixels, _mm_set1_epi32(pairWeights(w[k], w[k + 1]))));
+        }
+        if (k < n) {
+            __m128i pixel = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(p[k])), zero);
+            pixel         = _mm_unpacklo_epi16(pixel, zero);
+            acc           = _mm_add_epi32(acc, _mm_madd_epi16(pixel, _mm_set1_epi32(pairWeights(w[k], 0))));
+        }
+
+        acc    = _mm_srai_epi32(acc, PrecisionBits);
+        acc    = _mm_packs_epi32(acc, acc);
+        acc    = _mm_packus_epi16(acc, acc);
+        dst[x] = static_cast<quint32>(_mm_cvtsi128_si32(acc));
+    }
+}
+
+MEL_TARGET_AVX2 void verticalAvx2(const quint32 *const *rows, const qint16 *w, const int taps, quint32 *dst, const int width) {
+    const __m256i zero = _mm256_setzero_si256();
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        // unpack 按 128 位通道进行：acc0 = [像素0 | 像素4]，acc1 = [1 | 5]，acc2 = [2 | 6]，acc3 = [3 | 7]
+        __m256i acc0 = _mm256_set1_epi32(Rounding);
+        __m256i acc1 = acc0;
+        __m256i acc2 = acc0;
+        __m256i acc3 = acc0;
+
+        for (int k = 0; k < taps; k += 2) {
+            const __m256i a       = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[k] + x));
+            const __m256i b       = k + 1 < taps ? _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[k + 1] + x)) : zero;
+            const __m256i weights = _mm256_set1_epi32(pairWeights(w[k], k + 1 < taps ? w[k + 1] : 0));
+
+            const __m256i aLo = _mm256_unpacklo_epi8(a, zero);
+            const __m256i aHi = _mm256_unpackhi_epi8(a, zero);
+            const __m256i bLo = _mm256_unpacklo_epi8(b, zero);
+            const __m256i bHi = _mm256_unpackhi_epi8(b, zero);
+
+            acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_unpacklo_epi16(aLo, bLo), weights));
+            acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_unpackhi_epi16(aLo, bLo), weights));
+            acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(_mm256_unpacklo_epi16(aHi, bHi), weights));
+            acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(_mm256_unpackhi_epi16(aHi, bHi), weights));
+        }
+
+        // 按通道打包后顺序恢复为像素 0..7
+        const __m256i p01 = _mm256_packs_epi32(_mm256_srai_epi32(acc0, PrecisionBits), _mm256_srai_epi32(acc1, PrecisionBits));
+        const __m256i p23 = _mm256_packs_epi32(_mm256_srai_epi32(acc2, PrecisionBits), _mm256_srai_epi32(acc3, PrecisionBits));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), _mm256_packus_epi16(p01, p23));
+    }
+
+    verticalScalar(rows, w, taps, dst, x, width);
+}
+
+#endif // MEL_SIMD_X86
+
+// ========== 调度 ==========
+
+using HorizontalKernel = void (*)(const quint32 *, quint32 *, int, const Contributions &);
+using VerticalKernel   = void (*)(const quint32 *const *, const qint16 *, int, quint32 *, int);
+
+struct Kernels {
+    HorizontalKernel horizontal;
+    VerticalKernel   vertical;
+};
+
+Kernels kernelsFor(const Resampler::SimdLevel level) {
+#ifdef MEL_SIMD_X86
+    switch (level) {
+        case Resampler::Simd_AVX2:
+            return {horizontalAvx2, verticalAvx2};
+        case Resampler::Simd_SSE2:
+            return {horizontalSse2, verticalSse2};
+        default:
+            break;
+    }
+#else
+    Q_UNUSED(level);
+#endif
+    return {horizontalScalar, verticalScalarRow};
+}
+
+QImage scaleNearest(const QImage &source, const QSize &size, const int threadCount) {
+    QImage result(size, source.format());
+
+    QVector<int> columns(size.width());
+    for (int x = 0; x < size.width(); ++x) {
+        columns[x] = qMin(source.width() - 1, static_cast<int>((x + 0.5) * source.width() / size.width()));
+    }
+
+    // 非 const 的 scanLine 可能触发分离，只能在进入工作线程之前取一次
+    uchar *resultBits = result.bits();
+    parallelFor(size.height(), threadCount, MinRowsPerThread, [&](const int begin, const int end) {
+        for (int y = begin; y < end; ++y) {
+            const int  sy  = qMin(source.height() - 1, static_cast<int>((y + 0.5) * source.height() / size.height()));
+            const auto in  = reinterpret_cast<const quint32 *>(source.constScanLine(sy));
+            const auto out = reinterpret_cast<quint32 *>(resultBits + y * result.bytesPerLine());
+            for (int x = 0; x < size.width(); ++x) {
+                out[x] = in[columns[x]];
+            }
+        }
+    });
+    return result;
+}
+
+/**
+ * @brief Lanczos 的负瓣可能让预乘颜色超过 alpha，逐像素修正
+ */
+void clampPremultiplied(QImage &image) {
+    for (int y = 0; y < image.height(); ++y) {
+        auto *row = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x) {
+            const quint32 pixel = row[x];
+            const quint32 alpha = pixel >> 24;
+            const quint32 red   = qMin((pixel >> 16) & 0xFF, alpha);
+            const quint32 green = qMin((pixel >> 8) & 0xFF, alpha);
+            const quint32 blue  = qMin(pixel & 0xFF, alpha);
+            row[x]              = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+}
+
+} // namespace
+
+QImage Resampler::scale(const QImage &source, const QSize &size, const ScaleQuality quality) {
+    return scale(source, size, quality, detectSimdLevel(), 0);
+}
+
+QImage Resampler::scale(const QImage &image, const QSize &size, const ScaleQuality quality, const SimdLevel simdLevel, const int threadCount) {
+    if (image.isNull() || size.isEmpty()) {
+        return {};
+    }
+
+    const QImage source  = ImageLoader::toDisplayFormat(image);
+    const int    threads = threadCount > 0 ? threadCount : qMax(1, QThread::idealThreadCount());
+
+    if (source.size() == size) {
+        return source;
+    }
+
+    StatsBlock *stats = StatsScope::current();
+    stats->add(Counter_Scales);
+    StatsTimer timer(Histogram_ScaleTime, stats);
+
+    if (quality == ScaleQuality_Nearest) {
+        return scaleNearest(source, size, threads);
+    }
+
+    const Kernels kernels = kernelsFor(qMin(simdLevel, detectSimdLevel()));
+
+    // 水平方向：源高度 x 目标宽度的中间结果
+    QImage horizontal;
+    if (source.width() == size.width()) {
+        horizontal = source;
+    } else {
+        const Contributions columns = computeContributions(source.width(), size.width(), quality);
+        horizontal                  = QImage(size.width(), source.height(), source.format());
+        uchar *horizontalBits       = horizontal.bits();
+        parallelFor(source.height(), threads, MinRowsPerThread, [&](const int begin, const int end) {
+            for (int y = begin; y < end; ++y) {
+                kernels.horizontal(reinterpret_cast<const quint32 *>(source.constScanLine(y)), reinterpret_cast<quint32 *>(horizontalBits + y * horizontal.bytesPerLine()), size.width(), columns);
+            }
+        });
+    }
+
+    // 垂直方向
+    QImage result;
+    if (source.height() == size.height()) {
+        result = horizontal;
+    } else {
+        const Contributions rows = computeContributions(source.height(), size.height(), quality);
+        result                   = QImage(size, source.format());
+        uchar *resultBits        = result.bits();
+        parallelFor(size.height(), threads, MinRowsPerThread, [&](const int begin, const int end) {
+            QVarLengthArray<const quint32 *, 64> taps(rows.maxTaps);
+            for (int y = begin; y < end; ++y) {
+                const int count = rows.count[y];
+                for (int k = 0; k < count; ++k) {
+                    taps[k] = reinterpret_cast<const quint32 *>(horizontal.constScanLine(rows.start[y] + k));
+                }
+                kernels.vertical(taps.constData(), rows.weightsFor(y), count, reinterpret_cast<quint32 *>(resultBits + y * result.bytesPerLine()), size.width());
+            }
+        });
+    }
+
+    if (quality == ScaleQuality_Lanczos3 && result.format() == QImage::Format_ARGB32_Premultiplied) {
+        clampPremultiplied(result);
+    }
+    return result;
+}
+
+QImage Resampler::scaleReference(const QImage &source, const QSize &size, const ScaleQuality quality) {
+    return scale(source, size, quality, Simd_Scalar, 1);
+}
+
+Resampler::SimdLevel Resampler::detectSimdLevel() {
+    static const SimdLevel level = [] {
+#ifdef MEL_SIMD_X86
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx     = (info[2] & (1 << 28)) != 0;
+        // 操作系统需要保存 YMM 寄存器状态
+        const bool ymmState = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(info, 7, 0);
+        const bool avx2 = ymmState && (info[1] & (1 << 5)) != 0;
+        return avx2 ? Simd_AVX2 : Simd_SSE2;
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Simd_AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? Simd_SSE2 : Simd_Scalar;
+    #endif
+#else
+        return Simd_Scalar;
+#endif
+    }();
+    return level;
+}
+
+int Resampler::maxChannelDifference(const QImage &a, const QImage &b) {
+    if (a.size() != b.size() || a.format() != b.format() || a.depth() != 32) {
+        return -1;
+    }
+
+    int maxDiff = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const auto *rowA = reinterpret_cast<const quint32 *>(a.constScanLine(y));
+        const auto *rowB = reinterpret_cast<const quint32 *>(b.constScanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            for (int ch = 0; ch < 4; ++ch) {
+                const int diff = qAbs(static_cast<int>((rowA[x] >> (ch * 8)) & 0xFF) - static_cast<int>((rowB[x] >> (ch * 8)) & 0xFF));
+                maxDiff        = qMax(maxDiff, diff);
+            }
+        }
+    }
+    return maxDiff;
+}
+
+} // namespace Mel
@@ -0,0 +1,282 @@
+/**
+ * @file TiledImage.cpp
+ * @brief 分块图片实现
+ */
+
+#include "TiledImage.h"
+#include "ImageLoader.h"
+#include "core/BackgroundTask.h"
+#include "core/ResourceBundle.h"
+#include <QImageReader>
+#include <QVector>
+#include <QtMath>
+#include <cmath>
+
+namespace Mel {
+
+namespace {
+
+// 整级解码请求的列号（不支持区域解码时使用），超出任何一级的列数，不会与真实分块冲突
+constexpr int kLevelMarker = 0xFFFFFFF;
+
+/**
+ * @brief 按区域解码（工作线程中执行）
+ * @param path 图片路径
+ * @param sourceRect 原图中的区域（为空表示整张）
+ * @param outputSize 输出尺寸
+ */
+QImage decodeRegion(const QString &path, const QRect &sourceRect, const QSize &outputSize) {
+    QImageReader reader(path);
+    reader.setAutoTransform(false);
+    if (!sourceRect.isEmpty()) {
+        reader.setClipRect(sourceRect);
+    }
+
+    // 裁剪在缩放之前执行，缩放尺寸针对裁剪后的区域
+    const QSize regionSize = sourceRect.isEmpty() ? reader.size() : sourceRect.size();
+    if (outputSize.isValid() && outputSize != regionSize) {
+        reader.setScaledSize(outputSize);
+    }
+    return ImageLoader::toDisplayFormat(reader.read());
+}
+
+} // namespace
+
+TiledImage::TiledImage(QObject *parent)
+    : QObject(parent)
+    , _levelCount(0)
+    , _regionDecode(false)
+    , _bytes(0)
+    , _memoryLimit(128LL * 1024 * 1024)
+    , _generation(0) {
+}
+
+TiledImage::~TiledImage() = default;
+
+bool TiledImage::open(const QString &path, QString *errorString) {
+    ++_generation;
+    _tiles.clear();
+    _lru.clear();
+    _pending.clear();
+    _pinned.clear();
+    _bytes = 0;
+    _overview = QImage();
+    _size = QSize();
+    _levelCount = 0;
+    _path = path;
+
+    ResourceBundle::ensureLoadedFor(path);
+
+    QImageReader reader(path);
+    reader.setAutoTransform(false);
+    const QSize size = reader.size();
+    if (!size.isValid() || size.isEmpty()) {
+        if (errorString) {
+            *errorString = reader.errorString();
+        }
+        return false;
+    }
+
+    // 缩小到分块边长以内为止，最后一级只有一个分块
+    int levels  = 1;
+    int longest = qMax(size.width(), size.height());
+    while (longest > TileSize) {
+        longest = (longest + 1) / 2;
+        ++levels;
+    }
+
+    // 概览图只读取一次，JPEG 会在解码时直接缩小
+    const QSize overviewSize = size.scaled(QSize(OverviewSize, OverviewSize), Qt::KeepAspectRatio).boundedTo(size);
+    _regionDecode = reader.supportsOption(QImageIOHandler::ClipRect);
+    _overview = decodeRegion(path, QRect(), overviewSize);
+    if (_overview.isNull()) {
+        if (errorString) {
+            *errorString = QStringLiteral("无法解码图片: %1").arg(path);
+        }
+        return false;
+    }
+
+    _size = size;
+    _levelCount = levels;
+    return true;
+}
+
+QSize TiledImage::levelSize(const int level) const {
+    if (level < 0 || level >= _levelCount) {
+        return QSize();
+    }
+    const int factor = 1 << level;
+    return QSize((_size.width() + factor - 1) / factor, (_size.height() + factor - 1) / factor);
+}
+
+int TiledImage::levelForScale(const qreal scale) const {
+    if (_levelCount == 0 || scale <= 0) {
+        return 0;
+    }
+    if (scale >= 1.0) {
+        return 0;
+    }
+    // 2^-L >= scale，保证分块像素不少于屏幕像素
+    const int level = qFloor(std::log2(1.0 / scale));
+    return qBound(0, level, _levelCount - 1);
+}
+
+int TiledImage::usableLevel(const int level) const {
+    if (_regionDecode) {
+        return level;
+    }
+    // 整级解码会让整级像素常驻到切分完成，超过上限的级别改用更粗的一级
+    for (int candidate = qMax(0, level); candidate < _levelCount; ++candidate) {
+        const QSize size = levelSize(candidate);
+        if (qint64(size.width()) * size.height() * 4 <= _memoryLimit) {
+            return candidate;
+        }
+    }
+    return -1;
+}
+
+QSize TiledImage::gridSize(const int level) const {
+    const QSize size = levelSize(level);
+    if (!size.isValid()) {
+        return QSize();
+    }
+    return QSize((size.width() + TileSize - 1) / TileSize, (size.height() + TileSize - 1) / TileSize);
+}
+
+QRect TiledImage::tileRect(const int level, const int column, const int row) const {
+    return QRect(column * TileSize, row * TileSize, TileSize, TileSize) & QRect(QPoint(0, 0), levelSize(level));
+}
+
+QImage TiledImage::tile(const int level, const int column, const int row) {
+    const QSize grid = gridSize(level);
+    if (!grid.isValid() || column < 0 || row < 0 || column >= grid.width() || row >= grid.height()) {
+        return QImage();
+    }
+
+    // 命中与否都固定：解码完成后插入时不会被同一帧的其他分块挤出
+    const quint64 key = tileKey(level, column, row);
+    _pinned.insert(key);
+
+    auto it = _tiles.find(key);
+    if (it != _tiles.end()) {
+        // 移到最近使用的位置
+        _lru.splice(_lru.begin(), _lru, it->lru);
+        return it->image;
+    }
+
+    if (_regionDecode) {
+        requestTile(level, column, row);
+    } else if (usableLevel(level) == level) {
+        requestLevel(level);
+    }
+    return QImage();
+}
+
+void TiledImage::beginFrame() {
+    // 不在这里淘汰：本帧会重新固定仍然可见的分块，超出的部分在下次插入时淘汰
+    _pinned.clear();
+}
+
+void TiledImage::setMemoryLimit(const qint64 bytes) {
+    _memoryLimit = qMax<qint64>(0, bytes);
+    _pinned.clear();
+    trim();
+}
+
+quint64 TiledImage::tileKey(const int level, const int column, const int row) {
+    return (quint64(level) << 56) | (quint64(row) << 28) | quint64(column);
+}
+
+void TiledImage::insertTile(const quint64 key, const QImage &image) {
+    if (image.isNull() || _tiles.contains(key)) {
+        return;
+    }
+    _lru.push_front(key);
+    _tiles.insert(key, Tile{image, _lru.begin()});
+    _bytes += image.sizeInBytes();
+    trim();
+}
+
+void TiledImage::trim() {
+    // 从最久未使用的一端淘汰；固定的分块正在显示，淘汰后下一帧又会请求，跳过
+    auto it = _lru.end();
+    while (_bytes > _memoryLimit && it != _lru.begin()) {
+        --it;
+        if (_pinned.contains(*it)) {
+            continue;
+        }
+        _bytes -= _tiles.value(*it).image.sizeInBytes();
+        _tiles.remove(*it);
+        it = _lru.erase(it);
+    }
+}
+
+void TiledImage::requestTile(const int level, const int column, const int row) {
+    const quint64 key = tileKey(level, column, row);
+    if (_pending.contains(key)) {
+        return;
+    }
+    _pending.insert(key);
+
+    // 分块在本级中的区域映射回原图
+    const QRect   rect       = tileRect(level, column, row);
+    const int     factor     = 1 << level;
+    const QRect   sourceRect = QRect(rect.x() * factor, rect.y() * factor, rect.width() * factor, rect.height() * factor) & QRect(QPoint(0, 0), _size);
+    const QString path       = _path;
+    const quint64 generation = _generation;
+
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [path, sourceRect, size = rect.size()]() { return decodeRegion(path, sourceRect, size); },
+            [this, key, generation](const QImage &image) {
+                if (generation != _generation) {
+                    return;
+                }
+                _pending.remove(key);
+                if (!image.isNull()) {
+                    insertTile(key, image);
+                    Q_EMIT tileReady();
+                }
+            });
+}
+
+void TiledImage::requestLevel(const int level) {
+    const quint64 key = tileKey(level, kLevelMarker, 0);
+    if (_pending.contains(key)) {
+        return;
+    }
+    _pending.insert(key);
+
+    const QString path       = _path;
+    const QSize   size       = levelSize(level);
+    const quint64 generation = _generation;
+
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [path, size]() { return decodeRegion(path, QRect(), size); },
+            [this, key, level, generation](const QImage &image) {
+                if (generation != _generation) {
+                    return;
+                }
+                _pending.remove(key);
+                if (image.isNull()) {
+                    return;
+                }
+
+                // 切分为分块，整级图像随后释放；先插入未固定的分块，正在显示的分块最后插入、位于最近使用的一端
+                const QSize grid = gridSize(level);
+                for (const bool pinned : {false, true}) {
+                    for (int row = 0; row < grid.height(); ++row) {
+                        for (int column = 0; column < grid.width(); ++column) {
+                            const quint64 tileId = tileKey(level, column, row);
+                            if (_pinned.contains(tileId) == pinned) {
+                                insertTile(tileId, image.copy(tileRect(level, column, row)));
+                            }
+                        }
+                    }
+                }
+                Q_EMIT tileReady();
+            });
+}
+
+} // namespace Mel
@@ -0,0 +1,183 @@
+/**
+ * @file TiledImage.h
+ * @brief 分块图片 - 按区域解码超大图片，以多级分块的形式在内存上限内缓存
+ */
+
+#ifndef MEL_TILEDIMAGE_H
+#define MEL_TILEDIMAGE_H
+
+#include "Mel_export.h"
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <list>
+
+namespace Mel {
+
+/**
+ * @brief 分块图片
+ *
+ * 适用于 8K 照片、全景图等不适合整张放在内存中的图片：
+ * - 第 L 级为原图的 1/2^L，每级切分为 TileSize x TileSize 的分块
+ * - 分块在后台线程中通过 QImageReader::setClipRect + setScaledSize 只解码对应区域（JPEG 等支持区域解码的格式）；
+ *   不支持区域解码的格式（如 PNG）退回为按级别整体解码一次再切分，只有整级字节数不超过内存上限的级别才会这样解码
+ * - 分块按最近使用顺序缓存，总字节数不超过内存上限；当前帧用到的分块被固定，淘汰时跳过，
+ *   可见分块多于上限时暂时超出上限，而不是反复淘汰再重新解码
+ * - 打开时解码一张长边不超过 OverviewSize 的概览图，分块尚未就绪时用它代替
+ *
+ * 为了让区域坐标与文件一致，分块图片不应用 EXIF 旋转
+ */
+class MEL_EXPORT TiledImage : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int TileSize     = 512;  // 分块边长（像素）
+    static constexpr int OverviewSize = 1024; // 概览图长边上限（像素）
+
+    explicit TiledImage(QObject *parent = nullptr);
+
+    ~TiledImage() override;
+
+    /**
+     * @brief 打开图片（只读取文件头并解码概览图）
+     * @param path 图片路径
+     * @param errorString 可选，失败时写入错误信息
+     * @return 是否成功
+     */
+    bool open(const QString &path, QString *errorString = nullptr);
+
+    /**
+     * @brief 获取图片路径
+     */
+    [[nodiscard]] QString getPath() const { return _path; }
+
+    /**
+     * @brief 获取原图尺寸
+     */
+    [[nodiscard]] QSize getSize() const { return _size; }
+
+    /**
+     * @brief 是否支持按区域解码
+     */
+    [[nodiscard]] bool supportsRegionDecode() const { return _regionDecode; }
+
+    /**
+     * @brief 级数（第 0 级为原图）
+     */
+    [[nodiscard]] int levelCount() const { return _levelCount; }
+
+    /**
+     * @brief 获取指定级别的尺寸
+     */
+    [[nodiscard]] QSize levelSize(int level) const;
+
+    /**
+     * @brief 获取显示缩放比例（屏幕像素 / 原图像素）对应的级别（分块像素不少于屏幕像素的最小一级）
+     */
+    [[nodiscard]] int levelForScale(qreal scale) const;
+
+    /**
+     * @brief 获取实际可用的级别：支持区域解码时即为 level；否则为不细于 level、整级字节数不超过内存上限的第一级
+     * @return 可用级别，没有任何一级可以在上限内解码时返回 -1（只能显示概览图）
+     */
+    [[nodiscard]] int usableLevel(int level) const;
+
+    /**
+     * @brief 获取指定级别的分块行列数
+     */
+    [[nodiscard]] QSize gridSize(int level) const;
+
+    /**
+     * @brief 获取分块在所在级别中的区域
+     */
+    [[nodiscard]] QRect tileRect(int level, int column, int row) const;
+
+    /**
+     * @brief 获取分块（未缓存时返回空图片并在后台解码，完成后发出 tileReady 信号）
+     */
+    QImage tile(int level, int column, int row);
+
+    /**
+     * @brief 开始新的一帧：解除上一帧固定的分块
+     *
+     * 每次绘制前调用；之后通过 tile() 访问的分块在下一次调用前不会被淘汰
+     */
+    void beginFrame();
+
+    /**
+     * @brief 获取概览图
+     */
+    [[nodiscard]] QImage getOverview() const { return _overview; }
+
+    /**
+     * @brief 设置分块缓存的内存上限（同时解除固定的分块）
+     * @param bytes 字节数，默认128MB
+     */
+    void setMemoryLimit(qint64 bytes);
+
+    /**
+     * @brief 获取分块缓存的内存上限（字节）
+     */
+    [[nodiscard]] qint64 getMemoryLimit() const { return _memoryLimit; }
+
+    /**
+     * @brief 获取分块缓存当前占用的字节数（不含概览图）
+     */
+    [[nodiscard]] qint64 getMemoryBytes() const { return _bytes; }
+
+    /**
+     * @brief 获取已缓存的分块数量
+     */
+    [[nodiscard]] int getTileCount() const { return _tiles.size(); }
+
+Q_SIGNALS:
+    /**
+     * @brief 有新的分块解码完成
+     */
+    void tileReady();
+
+private:
+    struct Tile {
+        QImage                       image;
+        std::list<quint64>::iterator lru;
+    };
+
+    [[nodiscard]] static quint64 tileKey(int level, int column, int row);
+
+    /**
+     * @brief 插入分块并按内存上限淘汰最久未使用的分块
+     */
+    void insertTile(quint64 key, const QImage &image);
+
+    /**
+     * @brief 淘汰未固定的分块直到不超过内存上限
+     */
+    void trim();
+
+    /**
+     * @brief 在后台解码单个分块（支持区域解码时）
+     */
+    void requestTile(int level, int column, int row);
+
+    /**
+     * @brief 在后台整体解码一级并切分为分块（不支持区域解码时）
+     */
+    void requestLevel(int level);
+
+    QString              _path;         // 图片路径
+    QSize                _size;         // 原图尺寸
+    int                  _levelCount;   // 级数
+    bool                 _regionDecode; // 是否支持区域解码
+    QImage               _overview;     // 概览图
+    QHash<quint64, Tile> _tiles;        // 已缓存的分块
+    std::list<quint64>   _lru;          // 最近使用顺序（头部最新）
+    QSet<quint64>        _pending;      // 正在解码的分块（或整级）
+    QSet<quint64>        _pinned;       // 当前帧用到的分块，不参与淘汰
+    qint64               _bytes;        // 分块占用的字节数
+    qint64               _memoryLimit;  // 内存上限
+    quint64              _generation;   // 重新打开时递增，丢弃过期的解码结果
+};
+
+} // namespace Mel
+
+#endif // MEL_TILEDIMAGE_H
@@ -0,0 +1,420 @@
+/**
+ * @file AnimatedBackground.cpp
+ * @brief 动态背景实现
+ */
+
+#include "AnimatedBackground.h"
+#include "core/BackgroundTask.h"
+#include "core/ResourceBundle.h"
+#include "core/Logging.h"
+#include "image/ImageLoader.h"
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QImageReader>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+
+namespace Mel {
+
+namespace {
+
+/**
+ * @brief 帧时长过短时使用的时长（毫秒），与浏览器对 0/10ms 帧的处理一致
+ */
+constexpr int kDefaultFrameDelay = 100;
+
+} // namespace
+
+/**
+ * @brief 后台解码任务的结果
+ */
+struct AnimatedBackground::DecodedFrame {
+    int                           index      = -1;    // 帧序号
+    quint64                       generation = 0;     // 发起请求时的目标尺寸版本
+    QImage                        image;              // 缩放后的帧
+    int                           delay      = 0;     // 显示时长（毫秒）
+    std::shared_ptr<QImageReader> reader;             // 解码器（交还主线程，下一次继续顺序读取）
+    int                           readerPos  = 0;     // 解码器下一次读出的帧序号
+    bool                          ended      = false; // 请求的帧超出动画末尾（readerPos 即为帧数）
+    qint64                        nsecs      = 0;     // 解码和缩放耗时（纳秒）
+};
+
+AnimatedBackground::AnimatedBackground(QWidget *target)
+    : QObject(target)
+    , _target(target)
+    , _frameTimer(new QTimer(this))
+    , _dpr(1.0)
+    , _aspectMode(Qt::KeepAspectRatioByExpanding)
+    , _quality(ScaleQuality_Area)
+    , _readerPos(0)
+    , _frameCount(-1)
+    , _frameIndex(0)
+    , _frameDelay(kDefaultFrameDelay)
+    , _pendingIndex(-1)
+    , _waitingIndex(-1)
+    , _generation(0)
+    , _cacheBytes(0)
+    , _cacheLimit(64LL * 1024 * 1024)
+    , _playing(false)
+    , _active(false) {
+    _frameTimer->setSingleShot(true);
+    _frameTimer->setTimerType(Qt::PreciseTimer);
+    connect(_frameTimer, &QTimer::timeout, this, &AnimatedBackground::advance);
+
+    if (_target) {
+        _target->installEventFilter(this);
+    }
+}
+
+AnimatedBackground::~AnimatedBackground() {
+    if (_target) {
+        _target->removeEventFilter(this);
+    }
+    if (_topLevel) {
+        _topLevel->removeEventFilter(this);
+    }
+    if (_window) {
+        _window->removeEventFilter(this);
+    }
+}
+
+bool AnimatedBackground::isAnimated(const QString &path) {
+    ResourceBundle::ensureLoadedFor(path);
+    QImageReader reader(path);
+    return reader.supportsAnimation() && reader.imageCount() != 1;
+}
+
+bool AnimatedBackground::open(const QString &path, QString *errorString) {
+    ResourceBundle::ensureLoadedFor(path);
+    QImageReader reader(path);
+    if (!reader.canRead() || !reader.supportsAnimation()) {
+        if (errorString) {
+            *errorString = reader.canRead() ? QStringLiteral("不是动画图片: %1").arg(path) : reader.errorString();
+        }
+        return false;
+    }
+
+    ++_generation;
+    _frameTimer->stop();
+    clearCache();
+    _path         = path;
+    _pendingIndex = -1;
+    _reader.reset();
+    _readerPos    = 0;
+    _frameCount   = reader.imageCount() > 0 ? reader.imageCount() : -1;
+    _frameIndex   = 0;
+    _frameDelay   = kDefaultFrameDelay;
+    _waitingIndex = -1;
+    _currentFrame = QPixmap();
+    _stats        = AnimationStats();
+
+    qCDebug(lcMel) << "AnimatedBackground: 打开动画:" << path << "帧数:" << _frameCount << "尺寸:" << reader.size();
+    return true;
+}
+
+void AnimatedBackground::setTarget(const QSize &bounds, const Qt::AspectRatioMode aspectMode, const ScaleQuality quality, const qreal devicePixelRatio) {
+    const QSize physical = bounds * devicePixelRatio;
+    if (physical == _bounds && qFuzzyCompare(devicePixelRatio, _dpr) && aspectMode == _aspectMode && quality == _quality) {
+        return;
+    }
+
+    // 尺寸或设备像素比变化后所有缓存的帧都作废，当前帧按新尺寸重新缩放（完成前继续显示旧的帧）；
+    // 正在进行的解码仍持有旧的解码器，新的请求使用新的解码器，两者不会同时读取同一个解码器
+    _bounds       = physical;
+    _dpr          = devicePixelRatio;
+    _aspectMode   = aspectMode;
+    _quality      = quality;
+    _pendingIndex = -1;
+    _reader.reset();
+    _readerPos    = 0;
+    ++_generation;
+    clearCache();
+    updateActive();
+}
+
+void AnimatedBackground::setCacheLimit(const qint64 bytes) {
+    _cacheLimit = qMax<qint64>(0, bytes);
+    while (_cacheBytes > _cacheLimit && _cacheOrder.size() > 1) {
+        const CachedFrame frame = _cache.take(_cacheOrder.dequeue());
+        _cacheBytes -= ImageLoader::pixmapBytes(frame.pixmap);
+    }
+}
+
+void AnimatedBackground::start() {
+    _playing = true;
+    attachWindow();
+    updateActive();
+}
+
+void AnimatedBackground::stop() {
+    _playing = false;
+    _frameTimer->stop();
+}
+
+void AnimatedBackground::addPaintTime(const qint64 nsecs) {
+    _stats.cpuMs += static_cast<double>(nsecs) / 1e6;
+}
+
+bool AnimatedBackground::eventFilter(QObject *watched, QEvent *event) {
+    switch (event->type()) {
+        case QEvent::Show:
+        case QEvent::Hide:
+        case QEvent::WindowStateChange:
+        case QEvent::Expose:
+            if (watched == _target || watched == _topLevel || watched == _window) {
+                // 事件处理完成后控件和窗口的状态才更新，稍后再判断
+                QTimer::singleShot(0, this, [this]() {
+                    attachWindow();
+                    updateActive();
+                });
+            }
+            break;
+        case QEvent::Paint:
+            // 遮挡控件移开、隐藏或滚动回可见区域时，目标控件只会收到绘制事件
+            if (watched == _target && _playing && !_active) {
+                updateActive();
+            }
+            break;
+        default:
+            break;
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void AnimatedBackground::updateActive() {
+    _active = isTargetVisible();
+    if (!_playing || !_active || _path.isEmpty() || _bounds.isEmpty()) {
+        // 帧时钟完全停止，正在进行的解码完成后也不再预取
+        _frameTimer->stop();
+        return;
+    }
+
+    // 当前帧不在缓存中（刚打开或尺寸变化）时先解码当前帧，显示后才开始计时
+    if (!_cache.contains(_frameIndex)) {
+        _waitingIndex = _frameIndex;
+        requestFrame(_frameIndex);
+        return;
+    }
+
+    if (_currentFrame.isNull() || _waitingIndex == _frameIndex) {
+        showFrame(_frameIndex);
+        return;
+    }
+
+    // 从暂停中恢复：当前帧重新显示完整的时长
+    if (!_frameTimer->isActive() && _waitingIndex == -1) {
+        _frameTimer->start(_frameDelay);
+    }
+    prefetch();
+}
+
+bool AnimatedBackground::isTargetVisible() const {
+    if (!_target || !_target->isVisible()) {
+        return false;
+    }
+
+    const QWidget *topLevel = _target->window();
+    if (topLevel->isMinimized()) {
+        return false;
+    }
+    if (const QWindow *window = topLevel->windowHandle(); window && !window->isExposed()) {
+        return false;
+    }
+
+    // 被同一窗口中的其他控件完全遮挡
+    return !_target->visibleRegion().isEmpty();
+}
+
+void AnimatedBackground::attachWindow() {
+    if (!_target) {
+        return;
+    }
+
+    QWidget *topLevel = _target->window();
+    if (topLevel != _topLevel) {
+        if (_topLevel) {
+            _topLevel->removeEventFilter(this);
+        }
+        _topLevel = topLevel;
+        if (_topLevel && _topLevel != _target) {
+            _topLevel->installEventFilter(this);
+        }
+    }
+
+    QWindow *window = topLevel->windowHandle();
+    if (window != _window) {
+        if (_window) {
+            _window->removeEventFilter(this);
+        }
+        _window = window;
+        if (_window) {
+            _window->installEventFilter(this);
+        }
+    }
+}
+
+void AnimatedBackground::advance() {
+    // 控件被遮挡等没有事件通知的情况，在帧到期时检查
+    if (!isTargetVisible()) {
+        updateActive();
+        return;
+    }
+
+    const int next = nextIndex(_frameIndex);
+    if (_cache.contains(next)) {
+        ++_stats.cacheHits;
+        showFrame(next);
+        return;
+    }
+
+    // 下一帧尚未准备好：继续显示当前帧，解码完成后立即切换
+    ++_stats.lateFrames;
+    _waitingIndex = next;
+    requestFrame(next);
+}
+
+void AnimatedBackground::showFrame(const int index) {
+    const CachedFrame frame = _cache.value(index);
+    _frameIndex   = index;
+    _frameDelay   = frame.delay;
+    _currentFrame = frame.pixmap;
+    _waitingIndex = -1;
+    ++_stats.framesDisplayed;
+    Q_EMIT frameChanged(_currentFrame);
+
+    if (_playing && _active) {
+        _frameTimer->start(_frameDelay);
+        prefetch();
+    }
+}
+
+void AnimatedBackground::requestFrame(const int index) {
+    // 解码器只能顺序读取，同一时间只有一个任务使用它
+    if (_pendingIndex != -1 || _path.isEmpty() || _bounds.isEmpty()) {
+        return;
+    }
+    _pendingIndex = index;
+
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [path = _path, index, generation = _generation, reader = _reader, readerPos = _readerPos, bounds = _bounds, aspectMode = _aspectMode, quality = _quality]() mutable {
+                QElapsedTimer timer;
+                timer.start();
+
+                DecodedFrame decoded;
+                decoded.index      = index;
+                decoded.generation = generation;
+
+                // 请求的帧在解码器位置之前（循环回到开头）时重新打开
+                if (!reader || index < readerPos) {
+                    reader    = std::make_shared<QImageReader>(path);
+                    readerPos = 0;
+                }
+
+                // 跳过缓存中已有的帧：只解码不缩放
+                QImage frame;
+                int    delay = 0;
+                while (readerPos <= index && reader->canRead()) {
+                    frame = reader->read();
+                    if (frame.isNull()) {
+                        break;
+                    }
+                    delay = reader->nextImageDelay();
+                    ++readerPos;
+                }
+
+                if (readerPos <= index) {
+                    decoded.ended = true;
+                } else {
+                    const QSize size = frame.size().scaled(bounds, aspectMode);
+                    decoded.image    = Resampler::scale(ImageLoader::toDisplayFormat(frame), size, quality);
+                    decoded.delay    = delay > 10 ? delay : kDefaultFrameDelay;
+                }
+
+                decoded.reader    = std::move(reader);
+                decoded.readerPos = readerPos;
+                decoded.nsecs     = timer.nsecsElapsed();
+                return decoded;
+            },
+            [this](const DecodedFrame &decoded) { onFrameDecoded(decoded); });
+}
+
+void AnimatedBackground::onFrameDecoded(const DecodedFrame &decoded) {
+    // 打开新动画或目标变化之前发出的请求：解码器、位置和帧数都属于旧的状态，整个丢弃
+    if (decoded.generation != _generation) {
+        return;
+    }
+
+    _pendingIndex = -1;
+    _reader       = decoded.reader;
+    _readerPos    = decoded.readerPos;
+    _stats.cpuMs += static_cast<double>(decoded.nsecs) / 1e6;
+
+    if (decoded.ended) {
+        if (decoded.readerPos == 0) {
+            qCWarning(lcMel) << "AnimatedBackground: 无法解码动画:" << _path;
+            stop();
+            return;
+        }
+
+        // 第一次读到末尾才知道帧数，回到第一帧
+        _frameCount = decoded.readerPos;
+        if (_waitingIndex >= _frameCount) {
+            _waitingIndex = 0;
+        }
+    } else {
+        QElapsedTimer timer;
+        timer.start();
+        QPixmap pixmap = QPixmap::fromImage(decoded.image);
+        pixmap.setDevicePixelRatio(_dpr);
+        _stats.cpuMs += static_cast<double>(timer.nsecsElapsed()) / 1e6;
+        ++_stats.framesDecoded;
+        insertFrame(decoded.index, pixmap, decoded.delay);
+    }
+
+    if (_waitingIndex != -1) {
+        if (_cache.contains(_waitingIndex)) {
+            showFrame(_waitingIndex);
+        } else if (_playing && _active) {
+            requestFrame(_waitingIndex);
+        }
+        return;
+    }
+    prefetch();
+}
+
+void AnimatedBackground::prefetch() {
+    if (!_playing || !_active) {
+        return;
+    }
+    const int next = nextIndex(_frameIndex);
+    if (!_cache.contains(next)) {
+        requestFrame(next);
+    }
+}
+
+void AnimatedBackground::insertFrame(const int index, const QPixmap &pixmap, const int delay) {
+    if (pixmap.isNull() || _cache.contains(index)) {
+        return;
+    }
+
+    _cache.insert(index, CachedFrame{pixmap, delay});
+    _cacheOrder.enqueue(index);
+    _cacheBytes += ImageLoader::pixmapBytes(pixmap);
+
+    // 环形淘汰：最早缓存的帧最先被替换，至少保留刚插入的一帧
+    setCacheLimit(_cacheLimit);
+}
+
+void AnimatedBackground::clearCache() {
+    _cache.clear();
+    _cacheOrder.clear();
+    _cacheBytes = 0;
+}
+
+int AnimatedBackground::nextIndex(const int index) const {
+    return _frameCount > 0 ? (index + 1) % _frameCount : index + 1;
+}
+
+} // namespace Mel
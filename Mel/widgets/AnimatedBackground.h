@@ -0,0 +1,246 @@
+/**
+ * @file AnimatedBackground.h
+ * @brief 动态背景 - 播放 GIF/APNG/WebP 动画，缓存缩放后的帧，控件不可见时停止计时
+ */
+
+#ifndef MEL_ANIMATEDBACKGROUND_H
+#define MEL_ANIMATEDBACKGROUND_H
+
+#include "Mel_export.h"
+#include "image/Resampler.h"
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+#include <QQueue>
+#include <memory>
+
+class QImageReader;
+class QTimer;
+class QWidget;
+class QWindow;
+
+namespace Mel {
+
+/**
+ * @brief 动态背景的播放统计
+ */
+struct AnimationStats {
+    int    framesDisplayed = 0;   // 显示的帧数
+    int    framesDecoded   = 0;   // 解码并缩放的帧数
+    int    cacheHits       = 0;   // 直接使用缓存的帧数
+    int    lateFrames      = 0;   // 到期时尚未准备好的帧数
+    double cpuMs           = 0.0; // 解码、缩放、上传和绘制的累计耗时（毫秒）
+
+    /**
+     * @brief 每显示一帧的平均耗时（毫秒）
+     */
+    [[nodiscard]] double cpuMsPerFrame() const { return framesDisplayed > 0 ? cpuMs / framesDisplayed : 0.0; }
+};
+
+/**
+ * @brief 动态背景
+ *
+ * 与 QMovie 每帧都重新缩放不同：
+ * - 帧在后台线程中按顺序解码，每一帧只按目标尺寸缩放一次
+ * - 缩放后的帧保存在按字节数限制的环形缓存中，整段动画都能放进缓存时循环播放不再解码
+ * - 控件隐藏、被完全遮挡、窗口最小化或未暴露时帧时钟完全停止（不解码、不触发定时器），恢复后从当前帧继续
+ *
+ * 动画始终循环播放（忽略文件中的循环次数）
+ */
+class MEL_EXPORT AnimatedBackground : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 构造动态背景
+     * @param target 显示动画的控件（用于判断是否可见）
+     */
+    explicit AnimatedBackground(QWidget *target);
+
+    ~AnimatedBackground() override;
+
+    /**
+     * @brief 判断图片是否为动画（多于一帧）
+     */
+    [[nodiscard]] static bool isAnimated(const QString &path);
+
+    /**
+     * @brief 打开动画（只读取文件头，第一帧在设置目标尺寸后于后台解码）
+     * @param path 图片路径
+     * @param errorString 可选，失败时写入错误信息
+     * @return 是否成功
+     */
+    bool open(const QString &path, QString *errorString = nullptr);
+
+    /**
+     * @brief 获取图片路径
+     */
+    [[nodiscard]] QString getPath() const { return _path; }
+
+    /**
+     * @brief 设置帧的目标尺寸（变化时清空缓存并重新缩放当前帧）
+     * @param bounds 目标区域尺寸（逻辑像素）
+     * @param aspectMode 缩放方式
+     * @param quality 缩放质量
+     * @param devicePixelRatio 设备像素比（帧按物理像素缩放）
+     */
+    void setTarget(const QSize &bounds, Qt::AspectRatioMode aspectMode, ScaleQuality quality, qreal devicePixelRatio = 1.0);
+
+    /**
+     * @brief 设置缩放后帧缓存的内存上限
+     * @param bytes 字节数，默认64MB（至少保留一帧）
+     */
+    void setCacheLimit(qint64 bytes);
+
+    /**
+     * @brief 获取缓存的内存上限（字节）
+     */
+    [[nodiscard]] qint64 getCacheLimit() const { return _cacheLimit; }
+
+    /**
+     * @brief 获取缓存当前占用的字节数
+     */
+    [[nodiscard]] qint64 getCacheBytes() const { return _cacheBytes; }
+
+    /**
+     * @brief 获取帧数（第一次播放完整段动画之前为 -1）
+     */
+    [[nodiscard]] int getFrameCount() const { return _frameCount; }
+
+    /**
+     * @brief 获取当前显示的帧
+     */
+    [[nodiscard]] QPixmap currentFrame() const { return _currentFrame; }
+
+    /**
+     * @brief 开始播放（控件不可见时等到可见后才开始计时）
+     */
+    void start();
+
+    /**
+     * @brief 停止播放
+     */
+    void stop();
+
+    /**
+     * @brief 是否处于播放状态（可能因为不可见而暂停）
+     */
+    [[nodiscard]] bool isPlaying() const { return _playing; }
+
+    /**
+     * @brief 帧时钟是否正在运行（播放中且控件可见）
+     */
+    [[nodiscard]] bool isClockRunning() const { return _playing && _active; }
+
+    /**
+     * @brief 获取播放统计
+     */
+    [[nodiscard]] AnimationStats getStats() const { return _stats; }
+
+    /**
+     * @brief 计入绘制当前帧的耗时（由显示动画的控件调用）
+     */
+    void addPaintTime(qint64 nsecs);
+
+Q_SIGNALS:
+    /**
+     * @brief 显示的帧发生变化
+     */
+    void frameChanged(const QPixmap &frame);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct CachedFrame {
+        QPixmap pixmap;
+        int     delay; // 显示时长（毫秒）
+    };
+
+    struct DecodedFrame;
+
+    /**
+     * @brief 根据控件和窗口的可见性启动或停止帧时钟
+     */
+    void updateActive();
+
+    /**
+     * @brief 控件当前是否能被看到
+     */
+    [[nodiscard]] bool isTargetVisible() const;
+
+    /**
+     * @brief 关联目标控件当前所在的窗口
+     */
+    void attachWindow();
+
+    /**
+     * @brief 帧到期，切换到下一帧
+     */
+    void advance();
+
+    /**
+     * @brief 显示缓存中的帧并安排下一帧
+     */
+    void showFrame(int index);
+
+    /**
+     * @brief 在后台解码并缩放一帧（同一时间只有一个解码任务）
+     */
+    void requestFrame(int index);
+
+    /**
+     * @brief 处理解码结果
+     */
+    void onFrameDecoded(const DecodedFrame &decoded);
+
+    /**
+     * @brief 预取下一帧
+     */
+    void prefetch();
+
+    /**
+     * @brief 插入缓存并按内存上限淘汰最早的帧
+     */
+    void insertFrame(int index, const QPixmap &pixmap, int delay);
+
+    /**
+     * @brief 清空缓存
+     */
+    void clearCache();
+
+    /**
+     * @brief 获取某一帧之后的帧序号（帧数未知时直接加一）
+     */
+    [[nodiscard]] int nextIndex(int index) const;
+
+    QPointer<QWidget>             _target;       // 显示动画的控件
+    QPointer<QWidget>             _topLevel;     // 已安装事件过滤器的顶层控件
+    QPointer<QWindow>             _window;       // 已安装事件过滤器的窗口
+    QTimer                       *_frameTimer;   // 帧时钟
+    QString                       _path;         // 图片路径
+    QSize                         _bounds;       // 目标区域尺寸（物理像素）
+    qreal                         _dpr;          // 设备像素比
+    Qt::AspectRatioMode           _aspectMode;   // 缩放方式
+    ScaleQuality                  _quality;      // 缩放质量
+    std::shared_ptr<QImageReader> _reader;       // 顺序解码器（只在解码任务中使用）
+    int                           _readerPos;    // 解码器下一次读出的帧序号
+    int                           _frameCount;   // 帧数（未知时为 -1）
+    int                           _frameIndex;   // 当前显示的帧序号
+    int                           _frameDelay;   // 当前帧的显示时长（毫秒）
+    int                           _pendingIndex; // 正在解码的帧序号（无时为 -1）
+    int                           _waitingIndex; // 已到期、等待解码完成后显示的帧序号（无时为 -1）
+    quint64                       _generation;   // 打开新动画或目标尺寸变化时递增，丢弃过期的解码结果
+    QPixmap                       _currentFrame; // 当前显示的帧
+    QHash<int, CachedFrame>       _cache;        // 缩放后的帧
+    QQueue<int>                   _cacheOrder;   // 插入顺序（环形淘汰）
+    qint64                        _cacheBytes;   // 缓存占用的字节数
+    qint64                        _cacheLimit;   // 缓存内存上限
+    bool                          _playing;      // 是否处于播放状态
+    bool                          _active;       // 控件是否可见（帧时钟是否允许运行）
+    AnimationStats                _stats;        // 播放统计
+};
+
+} // namespace Mel
+
+#endif // MEL_ANIMATEDBACKGROUND_H
@@ -0,0 +1,60 @@
+/**
+ * @file BackgroundLayer.cpp
+ * @brief 背景图层实现
+ */
+
+#include "BackgroundLayer.h"
+
+namespace Mel {
+
+BackgroundLayer BackgroundLayer::image() {
+    return {};
+}
+
+BackgroundLayer BackgroundLayer::solid(const QColor &color) {
+    BackgroundLayer layer;
+    layer._type  = LayerType_Solid;
+    layer._brush = QBrush(color);
+    return layer;
+}
+
+BackgroundLayer BackgroundLayer::gradient(const QGradient &gradient) {
+    QGradient stretched = gradient;
+    // 相对坐标按绘制设备（控件或合成缓存）解释，而不是按每次填充的矩形
+    if (stretched.coordinateMode() != QGradient::LogicalMode) {
+        stretched.setCoordinateMode(QGradient::StretchToDeviceMode);
+    }
+
+    BackgroundLayer layer;
+    layer._type  = LayerType_Gradient;
+    layer._brush = QBrush(stretched);
+    return layer;
+}
+
+BackgroundLayer BackgroundLayer::overlay(const QImage &image) {
+    BackgroundLayer layer;
+    layer._type  = LayerType_Overlay;
+    layer._image = image;
+    return layer;
+}
+
+void BackgroundLayer::setOpacity(const qreal opacity) {
+    _opacity = qBound(0.0, opacity, 1.0);
+}
+
+bool BackgroundLayer::isOpaque() const {
+    if (!_visible || _opacity < 1.0 || (_blendMode != QPainter::CompositionMode_SourceOver && _blendMode != QPainter::CompositionMode_Source)) {
+        return false;
+    }
+
+    switch (_type) {
+        case LayerType_Solid:
+            return _brush.color().alpha() == 255;
+        case LayerType_Overlay:
+            return !_image.isNull() && !_image.hasAlphaChannel();
+        default:
+            return false;
+    }
+}
+
+} // namespace Mel
@@ -0,0 +1,130 @@
+/**
+ * @file BackgroundLayer.h
+ * @brief 背景图层 - BackgroundWidget 按顺序合成的图片、纯色、渐变和叠加图片层
+ */
+
+#ifndef MEL_BACKGROUNDLAYER_H
+#define MEL_BACKGROUNDLAYER_H
+
+#include "Mel_export.h"
+#include <QBrush>
+#include <QImage>
+#include <QPainter>
+
+namespace Mel {
+
+/**
+ * @brief 背景图层类型
+ */
+enum BackgroundLayerType {
+    LayerType_Image    = 0, // 背景图片（控件当前的背景图片，按缩放模式绘制）
+    LayerType_Solid    = 1, // 纯色填充
+    LayerType_Gradient = 2, // 渐变填充（如提高文字可读性的渐变、暗角）
+    LayerType_Overlay  = 3  // 叠加图片（拉伸覆盖整个控件，如噪点纹理）
+};
+
+/**
+ * @brief 背景图层
+ *
+ * 值类型，描述 BackgroundWidget 图层栈中的一层。图层按列表顺序从下到上绘制，
+ * 每层可以设置透明度和混合模式（QPainter::CompositionMode）
+ */
+class MEL_EXPORT BackgroundLayer {
+public:
+    /**
+     * @brief 默认构造为背景图片层
+     */
+    BackgroundLayer() = default;
+
+    /**
+     * @brief 创建背景图片层
+     */
+    static BackgroundLayer image();
+
+    /**
+     * @brief 创建纯色层
+     * @param color 填充颜色（包含透明度）
+     */
+    static BackgroundLayer solid(const QColor &color);
+
+    /**
+     * @brief 创建渐变层
+     *
+     * 非 LogicalMode 的渐变坐标（如 ObjectBoundingMode）按整个控件解释，
+     * 局部重绘时渐变位置保持不变
+     * @param gradient 渐变
+     */
+    static BackgroundLayer gradient(const QGradient &gradient);
+
+    /**
+     * @brief 创建叠加图片层
+     * @param image 叠加图片（拉伸覆盖整个控件）
+     */
+    static BackgroundLayer overlay(const QImage &image);
+
+    /**
+     * @brief 获取图层类型
+     */
+    [[nodiscard]] BackgroundLayerType getType() const { return _type; }
+
+    /**
+     * @brief 获取填充画刷（纯色层和渐变层）
+     */
+    [[nodiscard]] const QBrush &getBrush() const { return _brush; }
+
+    /**
+     * @brief 获取叠加图片（叠加图片层）
+     */
+    [[nodiscard]] const QImage &getImage() const { return _image; }
+
+    /**
+     * @brief 设置图层透明度
+     * @param opacity 透明度 (0.0-1.0)，默认1.0
+     */
+    void setOpacity(qreal opacity);
+
+    /**
+     * @brief 获取图层透明度
+     */
+    [[nodiscard]] qreal getOpacity() const { return _opacity; }
+
+    /**
+     * @brief 设置混合模式
+     * @param mode 混合模式，默认 CompositionMode_SourceOver
+     */
+    void setBlendMode(QPainter::CompositionMode mode) { _blendMode = mode; }
+
+    /**
+     * @brief 获取混合模式
+     */
+    [[nodiscard]] QPainter::CompositionMode getBlendMode() const { return _blendMode; }
+
+    /**
+     * @brief 设置图层是否可见
+     */
+    void setVisible(bool visible) { _visible = visible; }
+
+    /**
+     * @brief 图层是否可见
+     */
+    [[nodiscard]] bool isVisible() const { return _visible; }
+
+    /**
+     * @brief 图层是否完全覆盖下方内容（不透明的纯色或叠加图片，且未使用透明度和特殊混合模式）
+     *
+     * 背景图片层是否覆盖取决于控件的图片和缩放模式，这里始终返回 false
+     */
+    [[nodiscard]] bool isOpaque() const;
+
+private:
+    BackgroundLayerType       _type      = LayerType_Image;
+    QBrush                    _brush;                                            // 纯色层和渐变层的画刷
+    QImage                    _image;                                            // 叠加图片层的图片
+    qreal                     _opacity   = 1.0;                                  // 图层透明度
+    QPainter::CompositionMode _blendMode = QPainter::CompositionMode_SourceOver; // 混合模式
+    bool                      _visible   = true;                                 // 是否可见
+};
+
+} // namespace Mel
+
+#endif // MEL_BACKGROUNDLAYER_H
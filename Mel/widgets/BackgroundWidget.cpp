@@ -4,76 +4,444 @@
  */
 
 #include "BackgroundWidget.h"
-#include <QDebug>
+#include "PixelBudget.h"
+#include "image/ImageCache.h"
+#include "core/BackgroundTask.h"
+#include "image/BlurFilter.h"
+#include "image/DiskCache.h"
+#include "image/ImagePreview.h"
+#include "image/ImageLoader.h"
+#include "image/MipPyramid.h"
+#include "image/Resampler.h"
+#include "image/TiledImage.h"
+#include "core/Logging.h"
+#include "core/Stats.h"
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
 #include <QPropertyAnimation>
+#include <QTimer>
+#include <QWheelEvent>
+#include <QWindow>
+#include <QtMath>
+#include <utility>
 
 namespace Mel {
 
+namespace {
+
+/**
+ * @brief 将缩放模式映射为 Qt::AspectRatioMode
+ */
+Qt::AspectRatioMode toAspectRatioMode(const BackgroundScaleMode mode) {
+    switch (mode) {
+        case ScaleMode_Fill:
+            return Qt::KeepAspectRatioByExpanding; // 填满（可能裁剪）
+        case ScaleMode_Fit:
+            return Qt::KeepAspectRatio; // 适应（可能留空）
+        case ScaleMode_Stretch:
+            return Qt::IgnoreAspectRatio; // 拉伸（可能变形）
+        default:
+            return Qt::KeepAspectRatioByExpanding;
+    }
+}
+
+/**
+ * @brief 按显示尺寸解码时原图适配目标尺寸的方式
+ *
+ * 拉伸模式需要在两个方向上都覆盖目标尺寸，与填满模式相同
+ */
+Qt::AspectRatioMode toDecodeAspectMode(const BackgroundScaleMode mode) {
+    return mode == ScaleMode_Fit ? Qt::KeepAspectRatio : Qt::KeepAspectRatioByExpanding;
+}
+
+/**
+ * @brief 逐矩形绘制暴露区域的上限，超过时改为绘制外接矩形
+ */
+constexpr int kMaxPaintRects = 16;
+
+/**
+ * @brief 缩放结果写入磁盘缓存前等待尺寸稳定的时间（毫秒）
+ */
+constexpr int kDiskCacheDelay = 1000;
+
+/**
+ * @brief 把准备好的解码结果按请求的控件尺寸和缩放设置缩放（可在后台线程调用）
+ */
+void scalePrepared(PreparedBackground &request) {
+    if (request.image.isNull() || request.widgetSize.isEmpty()) {
+        return;
+    }
+    const QSize scaledSize = request.image.size().scaled(request.widgetSize * request.devicePixelRatio, toAspectRatioMode(request.scaleMode));
+    request.scaled         = Resampler::scale(request.image, scaledSize, request.scaleQuality);
+}
+
+/**
+ * @brief 从磁盘缓存中查找按请求的尺寸和缩放设置缩放好的结果（可在后台线程调用）
+ * @return 是否命中（命中时 image 和 scaled 都是映射的缩放结果）
+ */
+bool loadFromDiskCache(PreparedBackground &request) {
+    DiskCache &disk = DiskCache::instance();
+    if (!disk.isEnabled() || request.widgetSize.isEmpty()) {
+        return false;
+    }
+
+    const QString sourceKey = ImageCache::instance().sourceKey(request.path);
+    if (sourceKey.isEmpty()) {
+        return false;
+    }
+
+    const QImage image = disk.findScaled(ImageCache::scaledKey(sourceKey, request.widgetSize, request.scaleMode, request.scaleQuality, request.devicePixelRatio), &request.sourceSize);
+    if (image.isNull()) {
+        return false;
+    }
+    request.image         = image;
+    request.scaled        = image;
+    request.fromDiskCache = true;
+    return true;
+}
+
+/**
+ * @brief 分块模式的最大缩放：原图一个像素最多放大到 4 个控件像素
+ */
+constexpr qreal kMaxTiledPixelScale = 4.0;
+
+/**
+ * @brief 释放缓冲区后保留的占位缩略图长边（像素）
+ */
+constexpr int kPlaceholderSize = 128;
+
+} // namespace
+
 BackgroundWidget::BackgroundWidget(QWidget *parent) :
-    QWidget(parent), _scaleMode(ScaleMode_Fill), _smoothTransformation(true), _backgroundColor(QColor()) // 默认无效颜色（透明）
-  , _transitionAnimation(nullptr), _transitionOpacity(1.0), _transitionDuration(300)                     // 默认300毫秒
+    QWidget(parent), _scaleMode(ScaleMode_Fill), _scaleQuality(ScaleQuality_Area), _mipmapsEnabled(true), _mipBuildPending(false)
+  , _resizeIdleTimer(nullptr), _interactiveResize(true)
+  , _deferredRescales(0), _coalescedRescales(0), _loadMode(LoadMode_Sync), _loadSerial(0), _pendingLoads(0)
+  , _downsampleOnDecode(false), _redecodePending(false), _displayResolution(false), _diskCacheTimer(nullptr), _progressiveLoading(false)
+  , _compositeDirty(true)
+  , _tiledImage(nullptr), _tileMemoryLimit(128LL * 1024 * 1024), _zoom(1.0), _panZoomEnabled(true), _panning(false)
+  , _animation(nullptr), _animationCacheLimit(64LL * 1024 * 1024), _animationStarted(false)
+  , _trimPolicy(TrimPolicy_None), _trimTimer(nullptr), _trimmed(false), _trimSerial(0), _rescaleDpr(0.0)
+  , _blurSourceKey(0), _blurImageKey(0), _blurRadius(0), _blurSerial(0)
+  , _kenBurnsAnimation(nullptr), _kenBurnsImageKey(0), _kenBurnsSerial(0), _kenBurnsFrom(0.3, 0.4), _kenBurnsTo(0.7, 0.6), _kenBurnsZoom(1.2), _kenBurnsProgress(0.0)
+  , _kenBurnsDuration(30000), _kenBurnsEnabled(false)
+  , _backgroundColor(QColor())                                                                              // 默认无效颜色（透明）
+  , _transitionDriver(nullptr), _transitionOpacity(1.0), _transitionDuration(300)                        // 默认300毫秒
 {
     // 设置默认属性
     setAttribute(Qt::WA_StyledBackground, true);
 
+    // 本控件的运行时统计（计入全局）
+    _stats = Stats::instance().createBlock(QStringLiteral("BackgroundWidget"));
+
+    // 参与全局像素内存预算
+    PixelBudget::instance().registerWidget(this);
+
     // 创建过渡动画
-    _transitionAnimation = new QPropertyAnimation(this, "transitionOpacity", this);
-    _transitionAnimation->setDuration(_transitionDuration);
-    _transitionAnimation->setStartValue(0.0);
-    _transitionAnimation->setEndValue(1.0);
-    _transitionAnimation->setEasingCurve(QEasingCurve::InOutQuad);
+    // 跟随窗口的帧呈现节奏推进，慢的帧直接跳到当前时间对应的透明度
+    _transitionDriver = new TransitionDriver(this);
+    _transitionDriver->setDuration(_transitionDuration);
+    _transitionDriver->setEasingCurve(QEasingCurve::InOutQuad);
+    connect(_transitionDriver, &TransitionDriver::progressChanged, this, &BackgroundWidget::setTransitionOpacity);
+
+    // 动画结束后释放旧画面
+    connect(_transitionDriver, &TransitionDriver::finished, this, [this]() {
+        _oldFrame = QPixmap();
+        _stats->setGauge(Gauge_PixelBytes, getPixelMemoryBytes());
+        const TransitionStats stats = _transitionDriver->getStats();
+        _stats->add(Counter_TransitionFrames, stats.framesRendered);
+        _stats->add(Counter_TransitionDropped, stats.framesDropped);
+        qCDebug(lcMel) << "BackgroundWidget: 背景切换动画完成，绘制" << stats.framesRendered << "帧，掉帧" << stats.framesDropped << "最长帧间隔" << stats.worstFrameMs << "ms";
+        Q_EMIT transitionFinished();
+    });
+
+    // 调整大小停止后再执行高质量缩放
+    _resizeIdleTimer = new QTimer(this);
+    _resizeIdleTimer->setSingleShot(true);
+    _resizeIdleTimer->setInterval(150);
+    connect(_resizeIdleTimer, &QTimer::timeout, this, [this]() {
+        updateScaledPixmap();
+        update();
+    });
+
+    // 隐藏或最小化一段时间后再释放缓冲区，短暂的切换不受影响
+    _trimTimer = new QTimer(this);
+    _trimTimer->setSingleShot(true);
+    _trimTimer->setInterval(2000);
+    connect(_trimTimer, &QTimer::timeout, this, [this]() {
+        if (!isVisible() || window()->isMinimized()) {
+            trimBuffers(_trimPolicy);
+        }
+    });
 }
 
-BackgroundWidget::~BackgroundWidget() = default;
+BackgroundWidget::~BackgroundWidget() {
+    PixelBudget::instance().unregisterWidget(this);
+}
 
 // ========== 背景图片设置 ==========
 
 bool BackgroundWidget::setBackgroundImage(const QString &path) {
-    QPixmap pixmap;
-    if (!pixmap.load(path)) {
-        qWarning() << "BackgroundWidget: 无法加载图片:" << path;
+    // 解码耗时计入本控件（异步加载时随任务带到后台线程）
+    StatsScope scope(_stats);
+
+    // 新的请求会使之前尚未完成的异步加载失效
+    const quint64 serial = ++_loadSerial;
+
+    // 渐进加载：异步加载期间先拉伸显示预览
+    if (_progressiveLoading && _loadMode == LoadMode_Async) {
+        showPreview(path);
+    }
+
+    // 磁盘缓存按控件的最终尺寸查找；显示之前尺寸还不确定，照常解码，显示后缩放的结果再写入磁盘缓存
+    if (DiskCache::instance().isEnabled() && isVisible()) {
+        if (_loadMode == LoadMode_Async) {
+            // 在后台查找磁盘缓存，未命中时解码并缩放
+            ++_pendingLoads;
+            prepareBackground(path, this, [this, serial](const PreparedBackground &prepared) {
+                --_pendingLoads;
+                if (serial == _loadSerial) {
+                    setPreparedBackground(prepared);
+                }
+            });
+            return true;
+        }
+
+        PreparedBackground request = backgroundRequest(path);
+        if (loadFromDiskCache(request)) {
+            return setPreparedBackground(request);
+        }
+    }
+
+    // 内存精简模式下直接解码到显示所需的尺寸
+    const QSize               bounds     = decodeBoundingSize();
+    const Qt::AspectRatioMode decodeMode = toDecodeAspectMode(_scaleMode);
+
+    if (_loadMode == LoadMode_Async) {
+        ++_pendingLoads;
+        ImageLoader::loadAsync(path, bounds, decodeMode, this, [this, path, serial](const QImage &image, const QSize &sourceSize, const QString &errorString) {
+            --_pendingLoads;
+            onImageDecoded(path, serial, image, sourceSize, errorString);
+        });
+        return true;
+    }
+
+    QSize        sourceSize;
+    QString      errorString;
+    const QImage image = ImageLoader::load(path, bounds, decodeMode, &sourceSize, &errorString);
+    return onImageDecoded(path, serial, image, sourceSize, errorString);
+}
+
+void BackgroundWidget::setBackgroundPixmap(const QPixmap &pixmap) {
+    ++_loadSerial;
+    const QImage image = ImageLoader::toDisplayFormat(pixmap.toImage());
+    _sourcePath.clear();
+    _sourceKey.clear(); // 内存图片没有可共享的来源，缩放结果不放入进程级缓存
+    _sourceSize = pixmap.size();
+    applyBackgroundImage(image);
+}
+
+QPixmap BackgroundWidget::getBackgroundPixmap() const {
+    return QPixmap::fromImage(_backgroundImage);
+}
+
+bool BackgroundWidget::onImageDecoded(const QString &path, const quint64 serial, const QImage &image, const QSize &sourceSize, const QString &errorString) {
+    // 已被更新的请求取代，丢弃结果
+    if (serial != _loadSerial) {
+        qCDebug(lcMel) << "BackgroundWidget: 丢弃过期的加载结果:" << path;
+        return false;
+    }
+
+    if (image.isNull()) {
+        qCWarning(lcMel) << "BackgroundWidget: 无法加载图片:" << path << errorString;
+        resetPreview();
+        Q_EMIT loadFailed(path, errorString);
         return false;
     }
 
-    qDebug() << "BackgroundWidget: 加载图片成功:" << path << "尺寸:" << pixmap.size();
+    qCDebug(lcMel) << "BackgroundWidget: 加载图片成功:" << path << "尺寸:" << image.size() << "原始尺寸:" << sourceSize;
 
-    setBackgroundPixmap(pixmap);
+    _sourcePath        = path;
+    _sourceKey         = ImageCache::instance().isEnabled() || DiskCache::instance().isEnabled() ? ImageCache::instance().sourceKey(path) : QString();
+    _sourceSize        = sourceSize;
+    _displayResolution = false;
+    applyBackgroundImage(image);
+    storePreview(path, image);
+    Q_EMIT backgroundLoaded(path);
     return true;
 }
 
-void BackgroundWidget::setBackgroundPixmap(const QPixmap &pixmap) {
-    // 如果启用了动画且有旧图片
-    if (_transitionDuration > 0 && !_scaledBackground.isNull()) {
-        // 保存旧地缩放图片用于动画
-        _oldScaledBackground = _scaledBackground;
+void BackgroundWidget::prepareBackground(const QString &path, QObject *receiver, std::function<void(const PreparedBackground &)> callback) const {
+    // 在主线程中记录当前的控件尺寸和缩放设置，后台只读这份副本
+    PreparedBackground request = backgroundRequest(path);
 
-        // 设置新图片
-        _backgroundImage = pixmap;
-        updateScaledPixmap();
+    const QSize               bounds     = decodeBoundingSize();
+    const Qt::AspectRatioMode decodeMode = toDecodeAspectMode(_scaleMode);
+    runInBackground(
+            ImageLoader::threadPool(), receiver,
+            [request, bounds, decodeMode, stats = _stats]() mutable {
+                StatsScope scope(stats);
+                // 磁盘缓存中已有按相同尺寸缩放好的结果时不需要解码
+                if (loadFromDiskCache(request)) {
+                    return request;
+                }
+                request.image = ImageLoader::load(request.path, bounds, decodeMode, &request.sourceSize, &request.errorString);
+                scalePrepared(request);
+                return request;
+            },
+            [callback = std::move(callback)](const PreparedBackground &prepared) { callback(prepared); });
+}
+
+void BackgroundWidget::rescalePrepared(const PreparedBackground &prepared, QObject *receiver, std::function<void(const PreparedBackground &)> callback) const {
+    // 磁盘缓存中的图片只有准备时的显示分辨率，解码失败的没有可复用的结果：都重新准备
+    if (prepared.image.isNull() || prepared.fromDiskCache) {
+        prepareBackground(prepared.path, receiver, std::move(callback));
+        return;
+    }
+
+    PreparedBackground request = backgroundRequest(prepared.path);
+    request.image              = prepared.image;
+    request.sourceSize         = prepared.sourceSize;
+    runInBackground(
+            ImageLoader::threadPool(), receiver,
+            [request, stats = _stats]() mutable {
+                StatsScope scope(stats);
+                scalePrepared(request);
+                return request;
+            },
+            [callback = std::move(callback)](const PreparedBackground &prepared) { callback(prepared); });
+}
+
+bool BackgroundWidget::setPreparedBackground(const PreparedBackground &prepared) {
+    ++_loadSerial;
+
+    if (prepared.image.isNull()) {
+        qCWarning(lcMel) << "BackgroundWidget: 无法加载图片:" << prepared.path << prepared.errorString;
+        resetPreview();
+        Q_EMIT loadFailed(prepared.path, prepared.errorString);
+        return false;
+    }
+
+    _sourcePath        = prepared.path;
+    _sourceKey         = ImageCache::instance().isEnabled() || DiskCache::instance().isEnabled() ? ImageCache::instance().sourceKey(prepared.path) : QString();
+    _sourceSize        = prepared.sourceSize;
+    _displayResolution = prepared.fromDiskCache;
+    applyBackgroundImage(prepared.image, isPreparedFor(prepared) ? prepared.scaled : QImage());
+    storePreview(prepared.path, prepared.image);
+    Q_EMIT backgroundLoaded(prepared.path);
+    return true;
+}
+
+void BackgroundWidget::showPreview(const QString &path) {
+    // 已有画面时从当前画面过渡，不需要预览
+    if (!_scaledBackground.isNull() || _tiledImage || _animation || _trimmed) {
+        return;
+    }
+
+    // 只读取容器文件头或几 KB 的缓存文件，在主线程中查找
+    const QImage preview = ImagePreview::find(path);
+    _placeholder         = preview.isNull() ? QPixmap() : QPixmap::fromImage(preview);
+    invalidateComposite();
+    update();
+}
+
+void BackgroundWidget::resetPreview() {
+    if (_trimmed || _placeholder.isNull()) {
+        return;
+    }
+    _placeholder = QPixmap();
+    invalidateComposite();
+    update();
+}
+
+void BackgroundWidget::storePreview(const QString &path, const QImage &image) const {
+    if (!_progressiveLoading) {
+        return;
+    }
 
-        // 停止当前动画（如果正在运行）
-        if (_transitionAnimation->state() == QPropertyAnimation::Running) {
-            _transitionAnimation->stop();
+    // 缩小和写入磁盘都在后台进行；已有预览（构建时生成或之前保存）时跳过
+    ImageLoader::threadPool()->start([path, image]() {
+        if (ImagePreview::find(path).isNull()) {
+            ImagePreview::store(path, ImagePreview::generate(image));
         }
+    });
+}
+
+PreparedBackground BackgroundWidget::backgroundRequest(const QString &path) const {
+    PreparedBackground request;
+    request.path             = path;
+    request.widgetSize       = size();
+    request.devicePixelRatio = devicePixelRatioF();
+    request.scaleMode        = _scaleMode;
+    request.scaleQuality     = _scaleQuality;
+    return request;
+}
+
+bool BackgroundWidget::isPreparedFor(const PreparedBackground &prepared) const {
+    return !prepared.scaled.isNull() && prepared.widgetSize == size() && qFuzzyCompare(prepared.devicePixelRatio, devicePixelRatioF()) && prepared.scaleMode == _scaleMode
+        && prepared.scaleQuality == _scaleQuality;
+}
+
+void BackgroundWidget::applyBackgroundImage(const QImage &image, const QImage &prescaled) {
+    // 渐进加载时显示中的预览同样作为旧画面淡出（释放后的占位缩略图不算）
+    const bool showingPreview = !_trimmed && !_placeholder.isNull();
+
+    // 如果启用了动画且有旧图片
+    if (_transitionDuration > 0 && (!_scaledBackground.isNull() || _tiledImage || showingPreview)) {
+        // 保存切换前的画面用于动画（分块模式的画面也在这里保存，随后退出分块模式）
+        _oldFrame = currentFrame();
 
-        // 启动淡入动画
+        // 新图片替换被释放的缓冲区（隐藏期间设置的图片稍后再按策略释放）
+        discardTrimState();
+        resetTiledImage();
+        resetAnimation();
+
+        // 设置新图片
+        _backgroundImage = image;
+        _mipPyramid.reset();
+        updateScaledPixmap(prescaled);
+
+        // 启动淡入动画（正在运行时从头开始）
         _transitionOpacity = 0.0;
-        _transitionAnimation->start();
+        _transitionDriver->start();
 
-        qDebug() << "BackgroundWidget: 启动背景切换动画，时长:" << _transitionDuration << "ms";
+        qCDebug(lcMel) << "BackgroundWidget: 启动背景切换动画，时长:" << _transitionDuration << "ms";
     } else {
-        // 无动画或首次设置，直接切换
-        _backgroundImage = pixmap;
-        updateScaledPixmap();
+        // 无动画或首次设置，直接切换（结束正在进行的动画）
+        discardTrimState();
+        _transitionDriver->stop();
+        resetTiledImage();
+        resetAnimation();
+        _oldFrame        = QPixmap();
+        _backgroundImage = image;
+        _mipPyramid.reset();
+        updateScaledPixmap(prescaled);
         _transitionOpacity = 1.0;
         update();
     }
+
+    updateTrimState();
 }
 
 void BackgroundWidget::clearBackground() {
-    _backgroundImage  = QPixmap();
-    _scaledBackground = QPixmap();
+    ++_loadSerial;
+    discardTrimState();
+    _transitionDriver->stop();
+    _transitionOpacity = 1.0;
+    _oldFrame          = QPixmap();
+    _backgroundImage   = QImage();
+    _scaledBackground  = QPixmap();
+    _mipPyramid.reset();
+    resetBlur();
+    resetKenBurnsPixmap();
+    resetTiledImage();
+    resetAnimation();
+    invalidateComposite();
+    _sourcePath.clear();
+    _sourceKey.clear();
+    _sourceSize = QSize();
+    _stats->setGauge(Gauge_PixelBytes, getPixelMemoryBytes());
     update();
 }
 
@@ -83,9 +451,10 @@ void BackgroundWidget::setScaleMode(BackgroundScaleMode mode) {
     if (_scaleMode != mode) {
         _scaleMode = mode;
         updateScaledPixmap();
+        clampViewCenter();
         update();
 
-        qDebug() << "BackgroundWidget: 缩放模式切换到:" << (mode == ScaleMode_Fill ? "填满" : mode == ScaleMode_Fit ? "适应" : "拉伸");
+        qCDebug(lcMel) << "BackgroundWidget: 缩放模式切换到:" << (mode == ScaleMode_Fill ? "填满" : mode == ScaleMode_Fit ? "适应" : "拉伸");
     }
 }
 
@@ -93,151 +462,1531 @@ void BackgroundWidget::setScaleMode(BackgroundScaleMode mode) {
 
 void BackgroundWidget::setBackgroundColor(const QColor &color) {
     _backgroundColor = color;
+    invalidateComposite();
     update();
 }
 
 void BackgroundWidget::setOverlayColor(const QColor &color) {
     _overlayColor = color;
+    invalidateComposite();
     update();
 }
 
 void BackgroundWidget::clearOverlay() {
     _overlayColor = QColor();
+    invalidateComposite();
     update();
 }
 
-// ========== 高级选项 ==========
+// ========== 图层 ==========
 
-void BackgroundWidget::setSmoothTransformation(bool smooth) {
-    if (_smoothTransformation != smooth) {
-        _smoothTransformation = smooth;
-        updateScaledPixmap();
-        update();
+void BackgroundWidget::setLayers(const QList<BackgroundLayer> &layers) {
+    _layers = layers;
+    invalidateComposite();
+    update();
+}
+
+void BackgroundWidget::addLayer(const BackgroundLayer &layer) {
+    if (_layers.isEmpty()) {
+        _layers = getEffectiveLayers();
     }
+    _layers.append(layer);
+    invalidateComposite();
+    update();
 }
 
-// ========== 动画设置 ==========
+void BackgroundWidget::clearLayers() {
+    _layers.clear();
+    invalidateComposite();
+    update();
+}
 
-void BackgroundWidget::setTransitionDuration(int duration) {
-    _transitionDuration = qMax(0, duration);
-    if (_transitionAnimation) {
-        _transitionAnimation->setDuration(_transitionDuration);
+QList<BackgroundLayer> BackgroundWidget::getEffectiveLayers() const {
+    if (!_layers.isEmpty()) {
+        return _layers;
     }
 
-    qDebug() << "BackgroundWidget: 动画时长设置为:" << _transitionDuration << "ms";
+    // 默认图层：背景色（没有图片或 Fit 模式留空时可见）、图片、遮罩
+    QList<BackgroundLayer> layers;
+    const bool hasImage = !_scaledBackground.isNull() || !_placeholder.isNull() || _tiledImage;
+    if (_backgroundColor.isValid() && (!hasImage || _scaleMode == ScaleMode_Fit)) {
+        layers.append(BackgroundLayer::solid(_backgroundColor));
+    }
+    if (hasImage) {
+        layers.append(BackgroundLayer::image());
+    }
+    if (hasOverlay()) {
+        layers.append(BackgroundLayer::solid(_overlayColor));
+    }
+    return layers;
 }
 
-void BackgroundWidget::setTransitionOpacity(const qreal opacity) {
-    _transitionOpacity = qBound(0.0, opacity, 1.0);
-    update(); // 触发重绘
+// ========== 分块图片 ==========
+
+bool BackgroundWidget::setTiledBackground(const QString &path) {
+    auto   *tiled = new TiledImage(this);
+    QString errorString;
+    tiled->setMemoryLimit(_tileMemoryLimit);
+    if (!tiled->open(path, &errorString)) {
+        delete tiled;
+        qCWarning(lcMel) << "BackgroundWidget: 无法打开分块图片:" << path << errorString;
+        Q_EMIT loadFailed(path, errorString);
+        return false;
+    }
+
+    // 使尚未完成的异步加载失效
+    ++_loadSerial;
+
+    // 切换前的画面（普通图片或上一张分块图片）用于过渡动画
+    const bool    animate  = _transitionDuration > 0 && (!_scaledBackground.isNull() || _tiledImage);
+    const QPixmap oldFrame = animate ? currentFrame() : QPixmap();
+
+    resetTiledImage();
+    resetAnimation();
+    discardTrimState();
+    resetBlur();
+    resetKenBurnsPixmap();
+    _backgroundImage  = QImage();
+    _scaledBackground = QPixmap();
+    _mipPyramid.reset();
+    _sourcePath = path;
+    _sourceKey.clear();
+    _sourceSize = tiled->getSize();
+
+    _tiledImage = tiled;
+    connect(_tiledImage, &TiledImage::tileReady, this, qOverload<>(&QWidget::update));
+    _zoom       = 1.0;
+    _viewCenter = QRectF(QPointF(0, 0), QSizeF(_sourceSize)).center();
+    invalidateComposite();
+
+    qCDebug(lcMel) << "BackgroundWidget: 分块图片:" << path << "尺寸:" << _sourceSize << "级数:" << tiled->levelCount() << "区域解码:" << tiled->supportsRegionDecode();
+
+    if (animate) {
+        _oldFrame          = oldFrame;
+        _transitionOpacity = 0.0;
+        _transitionDriver->start();
+    } else {
+        _transitionDriver->stop();
+        _oldFrame          = QPixmap();
+        _transitionOpacity = 1.0;
+        update();
+    }
+
+    updateTrimState();
+    Q_EMIT backgroundLoaded(path);
+    return true;
 }
 
-// ========== 受保护方法 ==========
+void BackgroundWidget::setTileMemoryLimit(const qint64 bytes) {
+    _tileMemoryLimit = qMax<qint64>(0, bytes);
+    if (_tiledImage) {
+        _tiledImage->setMemoryLimit(_tileMemoryLimit);
+    }
+}
 
-void BackgroundWidget::paintEvent(QPaintEvent *event) {
-    // 如果没有背景图片、背景色和遮罩，完全等同于普通 QWidget
-    if (_scaledBackground.isNull() && !_backgroundColor.isValid() && !hasOverlay()) {
-        QWidget::paintEvent(event);
+void BackgroundWidget::setZoom(const qreal zoom, const QPointF &anchor) {
+    if (!_tiledImage) {
+        _zoom = 1.0;
         return;
     }
-    
-    Q_UNUSED(event);
 
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    // 缩放前后锚点下的原图坐标保持不变
+    const QPointF center(width() / 2.0, height() / 2.0);
+    const QPointF point      = anchor.isNull() ? center : anchor;
+    const qreal   oldScale   = tiledScale();
+    const QPointF imagePoint = _viewCenter + (point - center) / oldScale;
 
-    // 如果没有背景图片
-    if (_scaledBackground.isNull()) {
-        // 绘制背景色（如果有效）
-        if (_backgroundColor.isValid()) {
-            painter.fillRect(rect(), _backgroundColor);
-        }
+    const qreal baseScale = oldScale / _zoom;
+    const qreal maxZoom   = qMax(1.0, kMaxTiledPixelScale / baseScale);
+    _zoom                 = qBound(1.0, zoom, maxZoom);
 
-        // 绘制遮罩层（如果有）
-        if (hasOverlay()) {
-            painter.fillRect(rect(), _overlayColor);
-        }
+    _viewCenter = imagePoint - (point - center) / tiledScale();
+    clampViewCenter();
+    update();
+}
 
-        QWidget::paintEvent(event);
+void BackgroundWidget::setViewCenter(const QPointF &center) {
+    _viewCenter = center;
+    clampViewCenter();
+    update();
+}
+
+qreal BackgroundWidget::tiledScale() const {
+    if (!_tiledImage || width() <= 0 || height() <= 0) {
+        return 1.0;
+    }
+
+    // 拉伸模式按填满处理（分块按统一比例绘制）
+    const QSize size = _tiledImage->getSize();
+    const qreal sx   = static_cast<qreal>(width()) / size.width();
+    const qreal sy   = static_cast<qreal>(height()) / size.height();
+    const qreal base = _scaleMode == ScaleMode_Fit ? qMin(sx, sy) : qMax(sx, sy);
+    return base * _zoom;
+}
+
+void BackgroundWidget::clampViewCenter() {
+    if (!_tiledImage) {
         return;
     }
 
-    // 如果是 Fit 模式且有空白，先填充背景色（如果背景色有效）
-    if (_scaleMode == ScaleMode_Fit && _backgroundColor.isValid()) {
-        painter.fillRect(rect(), _backgroundColor);
+    const QSizeF size  = _tiledImage->getSize();
+    const qreal  scale = tiledScale();
+    const qreal  halfW = width() / (2.0 * scale);
+    const qreal  halfH = height() / (2.0 * scale);
+
+    // 图片小于控件的方向居中，否则不露出边缘
+    _viewCenter.setX(halfW * 2 >= size.width() ? size.width() / 2 : qBound(halfW, _viewCenter.x(), size.width() - halfW));
+    _viewCenter.setY(halfH * 2 >= size.height() ? size.height() / 2 : qBound(halfH, _viewCenter.y(), size.height() - halfH));
+}
+
+void BackgroundWidget::resetTiledImage() {
+    if (!_tiledImage) {
+        return;
+    }
+    delete _tiledImage;
+    _tiledImage = nullptr;
+    _zoom       = 1.0;
+    _panning    = false;
+}
+
+// ========== 动态背景 ==========
+
+bool BackgroundWidget::setAnimatedBackground(const QString &path) {
+    auto   *animation = new AnimatedBackground(this);
+    QString errorString;
+    animation->setCacheLimit(_animationCacheLimit);
+    if (!animation->open(path, &errorString)) {
+        delete animation;
+        qCWarning(lcMel) << "BackgroundWidget: 无法打开动态背景:" << path << errorString;
+        Q_EMIT loadFailed(path, errorString);
+        return false;
     }
 
-    // 如果正在进行过渡动画且有旧图片
-    if (_transitionOpacity < 1.0 && !_oldScaledBackground.isNull()) {
-        // 先绘制旧图片（完全不透明）
-        const int oldX = (width() - _oldScaledBackground.width()) / 2;
-        const int oldY = (height() - _oldScaledBackground.height()) / 2;
-        painter.drawPixmap(oldX, oldY, _oldScaledBackground);
+    // 使尚未完成的异步加载失效
+    ++_loadSerial;
 
-        // 再绘制新图片（带透明度）
-        painter.setOpacity(_transitionOpacity);
-        const int newX = (width() - _scaledBackground.width()) / 2;
-        const int newY = (height() - _scaledBackground.height()) / 2;
-        painter.drawPixmap(newX, newY, _scaledBackground);
-        painter.setOpacity(1.0); // 恢复透明度
+    // 第一帧在后台解码，完成前继续显示切换前的画面
+    const bool hasImage = !_scaledBackground.isNull() || _tiledImage;
+    _transitionDriver->stop();
+    _oldFrame          = hasImage ? currentFrame() : QPixmap();
+    _transitionOpacity = _oldFrame.isNull() ? 1.0 : 0.0;
 
-        // 动画完成后清除旧图片
-        if (_transitionOpacity >= 1.0) {
-            _oldScaledBackground = QPixmap();
-        }
-    } else {
-        // 正常绘制（无动画或动画已完成）
-        const int x = (width() - _scaledBackground.width()) / 2;
-        const int y = (height() - _scaledBackground.height()) / 2;
-        painter.drawPixmap(x, y, _scaledBackground);
+    resetTiledImage();
+    resetAnimation();
+    discardTrimState();
+    resetBlur();
+    resetKenBurnsPixmap();
+    _backgroundImage  = QImage();
+    _scaledBackground = QPixmap();
+    _mipPyramid.reset();
+    _sourcePath = path;
+    _sourceKey.clear();
+    _sourceSize = QSize();
+
+    _animation        = animation;
+    _animationStarted = false;
+    connect(_animation, &AnimatedBackground::frameChanged, this, &BackgroundWidget::onAnimationFrame);
+    invalidateComposite();
+
+    _animation->setTarget(size(), toAspectRatioMode(_scaleMode), _scaleQuality, devicePixelRatioF());
+    _animation->start();
+    update();
+    updateTrimState();
+    return true;
+}
+
+void BackgroundWidget::setAnimationCacheLimit(const qint64 bytes) {
+    _animationCacheLimit = qMax<qint64>(0, bytes);
+    if (_animation) {
+        _animation->setCacheLimit(_animationCacheLimit);
     }
+}
 
-    // 绘制遮罩层
-    if (hasOverlay()) {
-        painter.fillRect(rect(), _overlayColor);
+AnimationStats BackgroundWidget::getAnimationStats() const {
+    return _animation ? _animation->getStats() : AnimationStats();
+}
+
+void BackgroundWidget::onAnimationFrame(const QPixmap &frame) {
+    const QRect previous = _scaledBackground.isNull() ? QRect() : scaledPixmapRect(_scaledBackground);
+    _scaledBackground    = frame;
+
+    if (!_animationStarted) {
+        // 第一帧：从切换前的画面过渡过来
+        _animationStarted = true;
+        if (!_oldFrame.isNull() && _transitionDuration > 0) {
+            _transitionOpacity = 0.0;
+            _transitionDriver->start();
+        } else {
+            _oldFrame          = QPixmap();
+            _transitionOpacity = 1.0;
+        }
+        update();
+        Q_EMIT backgroundLoaded(_animation->getPath());
+        return;
     }
 
-    QWidget::paintEvent(event);
+    // 只重绘帧覆盖的区域（尺寸变化时连同上一帧的区域）
+    update(previous | scaledPixmapRect(frame));
 }
 
-void BackgroundWidget::resizeEvent(QResizeEvent *event) {
-    QWidget::resizeEvent(event);
+void BackgroundWidget::resetAnimation() {
+    if (!_animation) {
+        return;
+    }
+    delete _animation;
+    _animation        = nullptr;
+    _animationStarted = false;
+}
 
-    // 窗口大小改变时重新缩放背景图片
-    updateScaledPixmap();
+// ========== 毛玻璃 ==========
+
+void BackgroundWidget::setBlurRadius(const int radius) {
+    const int clamped = qBound(0, radius, BlurFilter::MaxRadius);
+    if (clamped == _blurRadius) {
+        return;
+    }
+
+    _blurRadius = clamped;
+    if (_blurRadius == 0) {
+        resetBlur();
+    } else {
+        // 重新模糊期间继续绘制旧半径的结果
+        _blurSourceKey = 0;
+        requestBlur();
+    }
+    requestKenBurnsPixmap();
+    invalidateComposite();
+    update();
 }
 
-// ========== 私有方法 ==========
+bool BackgroundWidget::isBlurReady() const {
+    return _blurRadius > 0 && !_blurredBackground.isNull() && _blurSourceKey == _scaledBackground.cacheKey();
+}
 
-void BackgroundWidget::updateScaledPixmap() {
-    if (_backgroundImage.isNull() || width() <= 0 || height() <= 0) {
-        _scaledBackground = QPixmap();
+void BackgroundWidget::requestBlur() {
+    if (_blurRadius <= 0 || _kenBurnsEnabled || _scaledBackground.isNull() || _tiledImage || _animation) {
         return;
     }
 
-    // 根据缩放模式选择 Qt::AspectRatioMode
-    Qt::AspectRatioMode aspectMode;
+    const qint64 sourceKey = _scaledBackground.cacheKey();
+    const qint64 imageKey  = _backgroundImage.cacheKey();
+    if (sourceKey == _blurSourceKey) {
+        return;
+    }
 
-    switch (_scaleMode) {
-        case ScaleMode_Fill:
-            aspectMode = Qt::KeepAspectRatioByExpanding; // 填满（可能裁剪）
-            break;
-        case ScaleMode_Fit:
-            aspectMode = Qt::KeepAspectRatio; // 适应（可能留空）
-            break;
-        case ScaleMode_Stretch:
-            aspectMode = Qt::IgnoreAspectRatio; // 拉伸（可能变形）
-            break;
-        default:
-            aspectMode = Qt::KeepAspectRatioByExpanding;
+    // 换了图片：旧的模糊结果不会再绘制，直接释放
+    if (imageKey != _blurImageKey) {
+        _blurredBackground = QPixmap();
     }
 
-    // 选择变换质量
-    const Qt::TransformationMode transMode = _smoothTransformation ? Qt::SmoothTransformation : Qt::FastTransformation;
+    const quint64 serial = ++_blurSerial;
+    const qreal   dpr    = _scaledBackground.devicePixelRatio();
+    const int     radius = qRound(_blurRadius * dpr);
 
-    // 缩放图片
-    _scaledBackground = _backgroundImage.scaled(size(), aspectMode, transMode);
+    auto apply = [this, sourceKey, imageKey](const QPixmap &blurred) {
+        _blurredBackground = blurred;
+        _blurSourceKey     = sourceKey;
+        _blurImageKey      = imageKey;
+        invalidateComposite();
+        update();
+    };
+
+    // 同一张图片、尺寸和半径的模糊结果在多个控件之间共享
+    ImageCache   &cache     = ImageCache::instance();
+    const QString scaledKey = scaledCacheKey(dpr);
+    const QString key       = scaledKey.isEmpty() ? QString() : scaledKey + QStringLiteral("|blur%1").arg(radius);
+    const QPixmap cached    = cache.findScaled(key);
+    if (!cached.isNull()) {
+        apply(cached);
+        return;
+    }
+
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [image = _scaledBackground.toImage(), radius, stats = _stats]() {
+                StatsScope scope(stats);
+                return BlurFilter::blur(image, radius);
+            },
+            [this, serial, sourceKey, key, apply](const QImage &blurred) {
+                // 期间又换了图片、尺寸或半径时丢弃
+                if (serial != _blurSerial || sourceKey != _scaledBackground.cacheKey()) {
+                    return;
+                }
+                const QPixmap pixmap = QPixmap::fromImage(blurred);
+                ImageCache::instance().insertScaled(key, pixmap);
+                apply(pixmap);
+            });
+}
+
+void BackgroundWidget::resetBlur() {
+    ++_blurSerial;
+    _blurredBackground = QPixmap();
+    _blurSourceKey     = 0;
+    _blurImageKey      = 0;
+}
+
+// ========== 平移缩放（Ken Burns） ==========
+
+void BackgroundWidget::setKenBurnsEnabled(const bool enabled) {
+    if (enabled == _kenBurnsEnabled) {
+        return;
+    }
+
+    _kenBurnsEnabled = enabled;
+    if (_kenBurnsEnabled) {
+        // 平移缩放画面自带缩放结果，不再需要模糊后的普通缩放结果
+        resetBlur();
+        requestKenBurnsPixmap();
+    } else {
+        resetKenBurnsPixmap();
+        requestBlur();
+    }
+    updateKenBurnsState();
+    invalidateComposite();
+    update();
+}
+
+void BackgroundWidget::setKenBurnsDuration(const int msec) {
+    _kenBurnsDuration = qMax(0, msec);
+    if (_kenBurnsAnimation) {
+        _kenBurnsAnimation->setDuration(qMax(1, _kenBurnsDuration));
+    }
+    updateKenBurnsState();
+}
+
+void BackgroundWidget::setKenBurnsZoom(const qreal zoom) {
+    const qreal clamped = qBound(1.0, zoom, 2.0);
+    if (qFuzzyCompare(clamped, _kenBurnsZoom)) {
+        return;
+    }
+    _kenBurnsZoom = clamped;
+    requestKenBurnsPixmap();
+    update();
+}
+
+void BackgroundWidget::setKenBurnsPath(const QPointF &from, const QPointF &to) {
+    _kenBurnsFrom = QPointF(qBound(0.0, from.x(), 1.0), qBound(0.0, from.y(), 1.0));
+    _kenBurnsTo   = QPointF(qBound(0.0, to.x(), 1.0), qBound(0.0, to.y(), 1.0));
+    update();
+}
+
+void BackgroundWidget::setKenBurnsProgress(const qreal progress) {
+    _kenBurnsProgress = progress - qFloor(progress);
+    if (isKenBurnsReady()) {
+        update();
+    }
+}
+
+bool BackgroundWidget::isKenBurnsReady() const {
+    return _kenBurnsEnabled && !_kenBurnsPixmap.isNull() && !_backgroundImage.isNull() && _kenBurnsImageKey == _backgroundImage.cacheKey();
+}
+
+QRectF BackgroundWidget::kenBurnsSourceRect() const {
+    // 往返一个周期：0 完全缩小，0.5 完全放大，两端平滑衔接（循环时不跳变）
+    const qreal  t      = (1.0 - qCos(2.0 * M_PI * _kenBurnsProgress)) / 2.0;
+    const qreal  zoom   = 1.0 + (_kenBurnsZoom - 1.0) * t;
+    const QSizeF pixmap = _kenBurnsPixmap.size();
+
+    // 完全缩小时取缩放结果中最大的控件比例区域，放大时按倍数缩小源矩形
+    const QSizeF  source = QSizeF(size()).scaled(pixmap, Qt::KeepAspectRatio) / zoom;
+    const QPointF focus  = _kenBurnsFrom + (_kenBurnsTo - _kenBurnsFrom) * t;
+    return {QPointF((pixmap.width() - source.width()) * focus.x(), (pixmap.height() - source.height()) * focus.y()), source};
+}
+
+void BackgroundWidget::requestKenBurnsPixmap() {
+    if (!_kenBurnsEnabled || _backgroundImage.isNull() || _trimmed || _tiledImage || _animation || width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    // 覆盖放大后的控件物理尺寸，超过原图时不再放大（绘制时再插值）
+    const qreal dpr    = devicePixelRatioF();
+    QSize       target = _backgroundImage.size().scaled(size() * dpr * _kenBurnsZoom, Qt::KeepAspectRatioByExpanding);
+    if (target.width() > _backgroundImage.width() || target.height() > _backgroundImage.height()) {
+        target = _backgroundImage.size();
+    }
+    const int radius = qRound(_blurRadius * dpr * _kenBurnsZoom);
+
+    const qint64  imageKey = _backgroundImage.cacheKey();
+    const QString request  = QStringLiteral("%1|%2x%3|%4").arg(imageKey).arg(target.width()).arg(target.height()).arg(radius);
+    if (request == _kenBurnsRequest) {
+        return;
+    }
+    _kenBurnsRequest = request;
+
+    // 换了图片：旧的缩放结果不会再绘制，直接释放
+    if (imageKey != _kenBurnsImageKey) {
+        _kenBurnsPixmap = QPixmap();
+    }
+
+    // 平滑缩小到一半以下时从金字塔中开始
+    const QImage source = _mipPyramid && _scaleQuality != ScaleQuality_Nearest ? _mipPyramid->levelFor(target) : _backgroundImage;
+
+    const quint64 serial = ++_kenBurnsSerial;
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [source, target, radius, quality = _scaleQuality, stats = _stats]() {
+                StatsScope scope(stats);
+                const QImage scaled = Resampler::scale(source, target, quality);
+                return radius > 0 ? BlurFilter::blur(scaled, radius) : scaled;
+            },
+            [this, serial, imageKey](const QImage &scaled) {
+                // 期间又换了图片、尺寸或参数时丢弃
+                if (serial != _kenBurnsSerial || imageKey != _backgroundImage.cacheKey()) {
+                    return;
+                }
+                _kenBurnsPixmap   = QPixmap::fromImage(scaled);
+                _kenBurnsImageKey = imageKey;
+                update();
+            });
+}
+
+void BackgroundWidget::resetKenBurnsPixmap() {
+    ++_kenBurnsSerial;
+    _kenBurnsPixmap   = QPixmap();
+    _kenBurnsImageKey = 0;
+    _kenBurnsRequest.clear();
+}
+
+void BackgroundWidget::updateKenBurnsState() {
+    const bool run = _kenBurnsEnabled && _kenBurnsDuration > 0 && isVisible() && !window()->isMinimized();
+    if (!run) {
+        if (_kenBurnsAnimation && _kenBurnsAnimation->state() == QAbstractAnimation::Running) {
+            _kenBurnsAnimation->pause();
+        }
+        return;
+    }
+
+    if (!_kenBurnsAnimation) {
+        // 线性推进，缓动由 kenBurnsSourceRect 的余弦曲线完成（无限循环时两端衔接）
+        _kenBurnsAnimation = new QPropertyAnimation(this, "kenBurnsProgress", this);
+        _kenBurnsAnimation->setStartValue(0.0);
+        _kenBurnsAnimation->setEndValue(1.0);
+        _kenBurnsAnimation->setLoopCount(-1);
+        _kenBurnsAnimation->setDuration(_kenBurnsDuration);
+    }
+    if (_kenBurnsAnimation->state() == QAbstractAnimation::Paused) {
+        _kenBurnsAnimation->resume();
+    } else if (_kenBurnsAnimation->state() == QAbstractAnimation::Stopped) {
+        // 从当前进度继续
+        _kenBurnsAnimation->start();
+        _kenBurnsAnimation->setCurrentTime(qRound(_kenBurnsProgress * _kenBurnsDuration));
+    }
+}
+
+// ========== 运行时统计 ==========
+
+StatsSnapshot BackgroundWidget::getStats() const {
+    StatsSnapshot snapshot             = _stats->snapshot();
+    snapshot.gauges[Gauge_PixelBytes] = getPixelMemoryBytes();
+    return snapshot;
+}
+
+qint64 BackgroundWidget::getPixelMemoryBytes() const {
+    qint64 bytes = _backgroundImage.sizeInBytes() + ImageLoader::pixmapBytes(_scaledBackground) + ImageLoader::pixmapBytes(_blurredBackground) + ImageLoader::pixmapBytes(_kenBurnsPixmap) + ImageLoader::pixmapBytes(_oldFrame) + ImageLoader::pixmapBytes(_composite) + ImageLoader::pixmapBytes(_placeholder);
+    if (_mipPyramid) {
+        bytes += _mipPyramid->memoryBytes();
+    }
+    if (_tiledImage) {
+        bytes += _tiledImage->getMemoryBytes() + _tiledImage->getOverview().sizeInBytes();
+    }
+    if (_animation) {
+        bytes += _animation->getCacheBytes();
+    }
+    return bytes;
+}
+
+// ========== 设备像素比 ==========
+
+void BackgroundWidget::onDevicePixelRatioChanged() {
+    const qreal dpr = devicePixelRatioF();
+
+    if (_animation) {
+        _animation->setTarget(size(), toAspectRatioMode(_scaleMode), _scaleQuality, dpr);
+        return;
+    }
+
+    // 分块按新的物理像素选择级别
+    if (_tiledImage) {
+        update();
+        return;
+    }
+
+    // 已按这个设备像素比缩放过（或正在缩放）
+    if (_scaledBackground.isNull() || qFuzzyCompare(_scaledBackground.devicePixelRatio(), dpr) || qFuzzyCompare(_rescaleDpr, dpr)) {
+        return;
+    }
+
+    // 合成缓存按新的设备像素比重新生成
+    invalidateComposite();
+    update();
+    if (_trimmed || _backgroundImage.isNull()) {
+        return;
+    }
+
+    // 在两块屏幕之间来回移动时，进程级缓存中通常已有另一种设备像素比的缩放结果
+    ImageCache &cache = ImageCache::instance();
+    if (!cache.findScaled(scaledCacheKey(dpr)).isNull()) {
+        updateScaledPixmap();
+        return;
+    }
+
+    qCDebug(lcMel) << "BackgroundWidget: 设备像素比变化:" << _scaledBackground.devicePixelRatio() << "->" << dpr << "，在后台重新缩放";
+
+    // 后台重新缩放，完成前旧的缩放结果按其自身的设备像素比拉伸绘制
+    const QSize scaledSize = scaledTargetSize();
+    QImage      source     = _backgroundImage;
+    if (_mipPyramid && _scaleQuality != ScaleQuality_Nearest && scaledSize.width() * 2 <= source.width() && scaledSize.height() * 2 <= source.height()) {
+        source = _mipPyramid->levelFor(scaledSize);
+    }
+
+    _rescaleDpr = dpr;
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [source, scaledSize, quality = _scaleQuality, stats = _stats]() {
+                StatsScope scope(stats);
+                return Resampler::scale(source, scaledSize, quality);
+            },
+            [this, serial = _loadSerial, widgetSize = size(), dpr](const QImage &scaled) {
+                if (qFuzzyCompare(_rescaleDpr, dpr)) {
+                    _rescaleDpr = 0.0;
+                }
+                // 期间换了图片、尺寸或又换了屏幕时丢弃（对应的路径会重新缩放）
+                if (serial != _loadSerial || _trimmed || widgetSize != size() || !qFuzzyCompare(dpr, devicePixelRatioF())) {
+                    return;
+                }
+                updateScaledPixmap(scaled);
+                update();
+            });
+}
+
+// ========== 内存释放 ==========
+
+void BackgroundWidget::setTrimPolicy(const BackgroundTrimPolicy policy) {
+    _trimPolicy = policy;
+    updateTrimState();
+}
+
+void BackgroundWidget::setTrimDelay(const int msec) {
+    _trimTimer->setInterval(qMax(0, msec));
+}
+
+int BackgroundWidget::getTrimDelay() const {
+    return _trimTimer->interval();
+}
+
+void BackgroundWidget::updateTrimState() {
+    const bool hidden = !isVisible() || window()->isMinimized();
+    if (!hidden) {
+        _trimTimer->stop();
+        if (_trimmed) {
+            restoreBuffers();
+        }
+        return;
+    }
+
+    if (_trimmed) {
+        // 恢复尚未完成又被隐藏：放弃这次恢复（也可能是超出像素内存预算时释放的）
+        ++_trimSerial;
+    } else if (_trimPolicy == TrimPolicy_None) {
+        _trimTimer->stop();
+    } else if (!_trimTimer->isActive()) {
+        _trimTimer->start();
+    }
+}
+
+void BackgroundWidget::trimBuffers(const BackgroundTrimPolicy policy) {
+    if (policy == TrimPolicy_None || _trimmed) {
+        return;
+    }
+
+    // 分块图片和动态背景只清空缓存，重新显示时按需解码
+    if (_tiledImage) {
+        _tiledImage->setMemoryLimit(0);
+        _trimmed = true;
+        return;
+    }
+    if (_animation) {
+        _animation->setCacheLimit(0);
+        _trimmed = true;
+        return;
+    }
+    if (_backgroundImage.isNull()) {
+        return;
+    }
+
+    // 占位缩略图：重新显示时先拉伸绘制，后台恢复完成后替换
+    const QSize thumbSize = _backgroundImage.size().scaled(QSize(kPlaceholderSize, kPlaceholderSize), Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+    _placeholder          = QPixmap::fromImage(Resampler::scale(_mipPyramid ? _mipPyramid->levelFor(thumbSize) : _backgroundImage, thumbSize, ScaleQuality_Area));
+
+    qint64 released = ImageLoader::pixmapBytes(_scaledBackground) + ImageLoader::pixmapBytes(_blurredBackground) + ImageLoader::pixmapBytes(_kenBurnsPixmap) + ImageLoader::pixmapBytes(_oldFrame) + ImageLoader::pixmapBytes(_composite) + (_mipPyramid ? _mipPyramid->memoryBytes() : 0);
+    _transitionDriver->stop();
+    _transitionOpacity = 1.0;
+    _oldFrame          = QPixmap();
+    _scaledBackground  = QPixmap();
+    _mipPyramid.reset();
+    resetBlur();
+    resetKenBurnsPixmap();
+    invalidateComposite();
+
+    // 原图只有在能从来源路径重新读取时才释放；进程级缓存中的原图和缩放结果也要移除，否则像素仍然常驻
+    if (policy == TrimPolicy_All && !_sourcePath.isEmpty()) {
+        released += _backgroundImage.sizeInBytes();
+        _backgroundImage = QImage();
+        ImageCache::instance().release(_sourceKey);
+    }
+
+    _trimmed = true;
+    _stats->setGauge(Gauge_PixelBytes, getPixelMemoryBytes());
+    qCDebug(lcMel) << "BackgroundWidget: 隐藏时释放像素缓冲区:" << released << "字节";
+}
+
+void BackgroundWidget::restoreBuffers() {
+    if (!_trimmed) {
+        return;
+    }
+    const quint64 serial = ++_trimSerial;
+
+    if (_tiledImage) {
+        _tiledImage->setMemoryLimit(_tileMemoryLimit);
+        _trimmed = false;
+        update();
+        return;
+    }
+    if (_animation) {
+        _animation->setCacheLimit(_animationCacheLimit);
+        _trimmed = false;
+        return;
+    }
+
+    if (_backgroundImage.isNull()) {
+        // 原图也已释放：在后台重新解码并缩放
+        prepareBackground(_sourcePath, this, [this, serial](const PreparedBackground &prepared) {
+            if (serial != _trimSerial || !_trimmed) {
+                return;
+            }
+            if (prepared.image.isNull()) {
+                qCWarning(lcMel) << "BackgroundWidget: 无法恢复背景图片:" << prepared.path << prepared.errorString;
+                return;
+            }
+            _trimmed           = false;
+            _backgroundImage   = prepared.image;
+            _sourceSize        = prepared.sourceSize;
+            _displayResolution = prepared.fromDiskCache;
+            updateScaledPixmap(isPreparedFor(prepared) ? prepared.scaled : QImage());
+            _placeholder = QPixmap();
+            update();
+        });
+        return;
+    }
+
+    // 只释放了缩放结果：在后台重新缩放
+    const QSize scaledSize = scaledTargetSize();
+    runInBackground(
+            ImageLoader::threadPool(), this,
+            [image = _backgroundImage, scaledSize, quality = _scaleQuality, stats = _stats]() {
+                StatsScope scope(stats);
+                return Resampler::scale(image, scaledSize, quality);
+            },
+            [this, serial](const QImage &scaled) {
+                if (serial != _trimSerial || !_trimmed) {
+                    return;
+                }
+                _trimmed = false;
+                updateScaledPixmap(scaled);
+                _placeholder = QPixmap();
+                update();
+            });
+}
+
+qint64 BackgroundWidget::releaseDerivableBuffers() {
+    const qint64 before = getPixelMemoryBytes();
+
+    // 隐藏或最小化：与按策略释放相同，重新显示时在后台恢复
+    if (!isVisible() || window()->isMinimized()) {
+        trimBuffers(TrimPolicy_All);
+    } else {
+        // 可见：图片金字塔在下次缩放时重新构建，合成缓存改为逐层绘制（图层或尺寸变化时才重新合成）
+        _mipPyramid.reset();
+        _composite      = QPixmap();
+        _compositeDirty = false;
+    }
+
+    const qint64 after = getPixelMemoryBytes();
+    if (after < before) {
+        _stats->add(Counter_BudgetEvictions);
+        _stats->setGauge(Gauge_PixelBytes, after);
+    }
+    return before - after;
+}
+
+void BackgroundWidget::discardTrimState() {
+    ++_trimSerial;
+    _trimmed     = false;
+    _placeholder = QPixmap();
+}
+
+// ========== 高级选项 ==========
+
+void BackgroundWidget::setSmoothTransformation(bool smooth) {
+    setScaleQuality(smooth ? ScaleQuality_Area : ScaleQuality_Nearest);
+}
+
+void BackgroundWidget::setScaleQuality(const ScaleQuality quality) {
+    if (_scaleQuality != quality) {
+        _scaleQuality = quality;
+        updateScaledPixmap();
+        update();
+    }
+}
+
+void BackgroundWidget::setDownsampleOnDecode(const bool enabled) {
+    if (_downsampleOnDecode != enabled) {
+        _downsampleOnDecode = enabled;
+        if (enabled) {
+            updateScaledPixmap();
+            update();
+        } else if (!_sourcePath.isEmpty() && _backgroundImage.size() != _sourceSize) {
+            // 关闭后恢复完整原图
+            setBackgroundImage(_sourcePath);
+        }
+    }
+}
+
+void BackgroundWidget::setProgressiveLoading(const bool enabled) {
+    if (_progressiveLoading != enabled) {
+        _progressiveLoading = enabled;
+        if (!enabled) {
+            resetPreview();
+        }
+    }
+}
+
+void BackgroundWidget::setMipmapsEnabled(const bool enabled) {
+    if (_mipmapsEnabled != enabled) {
+        _mipmapsEnabled = enabled;
+        if (!enabled) {
+            _mipPyramid.reset();
+        }
+    }
+}
+
+qint64 BackgroundWidget::getMipmapMemoryBytes() const {
+    return _mipPyramid ? _mipPyramid->memoryBytes() : 0;
+}
+
+void BackgroundWidget::setInteractiveResize(const bool enabled) {
+    if (_interactiveResize != enabled) {
+        _interactiveResize = enabled;
+        // 关闭时立即完成被推迟的缩放
+        if (!enabled && _deferredRescales > 0) {
+            updateScaledPixmap();
+            update();
+        }
+    }
+}
+
+void BackgroundWidget::setResizeIdleTimeout(const int msec) {
+    _resizeIdleTimer->setInterval(qMax(0, msec));
+}
+
+int BackgroundWidget::getResizeIdleTimeout() const {
+    return _resizeIdleTimer->interval();
+}
+
+// ========== 动画设置 ==========
+
+void BackgroundWidget::setTransitionDuration(int duration) {
+    _transitionDuration = qMax(0, duration);
+    if (_transitionDriver) {
+        _transitionDriver->setDuration(_transitionDuration);
+    }
+
+    qCDebug(lcMel) << "BackgroundWidget: 动画时长设置为:" << _transitionDuration << "ms";
+}
+
+TransitionStats BackgroundWidget::getTransitionStats() const {
+    return _transitionDriver->getStats();
+}
+
+bool BackgroundWidget::isTransitionRunning() const {
+    return _transitionDriver->isRunning();
+}
+
+void BackgroundWidget::setTransitionOpacity(const qreal opacity) {
+    _transitionOpacity = qBound(0.0, opacity, 1.0);
+    update(); // 触发重绘
+}
+
+// ========== 受保护方法 ==========
+
+bool BackgroundWidget::event(QEvent *event) {
+    const bool result = QWidget::event(event);
+
+    // 屏幕变化（或同一屏幕的缩放比例变化）在基类处理之后设备像素比才是新的值
+    switch (event->type()) {
+        case QEvent::ObjectNameChange:
+            _stats->setName(objectName());
+            break;
+        case QEvent::ScreenChangeInternal:
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+        case QEvent::DevicePixelRatioChange:
+#endif
+            onDevicePixelRatioChanged();
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+void BackgroundWidget::paintEvent(QPaintEvent *event) {
+    // 如果没有任何图层（背景图片、背景色和遮罩）也没有过渡动画，完全等同于普通 QWidget
+    if (_oldFrame.isNull() && getEffectiveLayers().isEmpty()) {
+        QWidget::paintEvent(event);
+        return;
+    }
+
+    // 图层或尺寸变化后重新合成一次（调整大小期间逐层绘制，空闲后再合成）
+    if (_compositeDirty && _deferredRescales == 0) {
+        rebuildComposite();
+    }
+
+    StatsTimer timer(Histogram_PaintTime, _stats.get());
+    _stats->add(Counter_Paints);
+
+    if (_tiledImage) {
+        _tiledImage->beginFrame();
+    }
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    // 只重绘暴露区域：子控件的局部更新（光标闪烁、悬停）不再重新混合整张背景
+    const QRegion &region = event->region();
+    if (region.rectCount() > kMaxPaintRects) {
+        // 矩形过多时逐个绘制的开销反而更大，合并为外接矩形
+        paintExposedRect(painter, region.boundingRect());
+    } else {
+        for (const QRect &exposed : region) {
+            paintExposedRect(painter, exposed);
+        }
+    }
+
+    _stats->setGauge(Gauge_PixelBytes, getPixelMemoryBytes());
+    PixelBudget::instance().touch(this);
+    _transitionDriver->framePresented();
+    QWidget::paintEvent(event);
+}
+
+void BackgroundWidget::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+
+    // 分块模式按新尺寸重新计算可见分块，不需要缩放
+    clampViewCenter();
+
+    // 交互式调整大小：先拉伸绘制上一次的缩放结果，空闲后再重新缩放
+    if (_interactiveResize && isVisible() && !_scaledBackground.isNull()) {
+        ++_deferredRescales;
+        _resizeIdleTimer->start();
+        return;
+    }
+
+    // 窗口大小改变时重新缩放背景图片
+    updateScaledPixmap();
+}
+
+void BackgroundWidget::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+
+    // 最小化只通知顶层窗口，在顶层窗口上监听状态变化（控件可能被移动到了其他窗口）
+    QWidget *topLevel = window();
+    if (topLevel != _trimWindow) {
+        if (_trimWindow) {
+            _trimWindow->removeEventFilter(this);
+        }
+        _trimWindow = topLevel;
+        _trimWindow->installEventFilter(this);
+    }
+
+    // 窗口移动到其他屏幕时按新的设备像素比重新缩放
+    QWindow *handle = topLevel->windowHandle();
+    if (handle != _screenWindow) {
+        if (_screenWindow) {
+            disconnect(_screenWindow, &QWindow::screenChanged, this, nullptr);
+        }
+        _screenWindow = handle;
+        if (_screenWindow) {
+            connect(_screenWindow, &QWindow::screenChanged, this, &BackgroundWidget::onDevicePixelRatioChanged);
+        }
+    }
+
+    // 隐藏期间可能换过屏幕
+    onDevicePixelRatioChanged();
+    updateTrimState();
+    updateKenBurnsState();
+}
+
+void BackgroundWidget::hideEvent(QHideEvent *event) {
+    QWidget::hideEvent(event);
+    updateTrimState();
+    updateKenBurnsState();
+}
+
+bool BackgroundWidget::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == _trimWindow && event->type() == QEvent::WindowStateChange) {
+        updateTrimState();
+        updateKenBurnsState();
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void BackgroundWidget::mousePressEvent(QMouseEvent *event) {
+    if (_tiledImage && _panZoomEnabled && event->button() == Qt::LeftButton) {
+        _panning    = true;
+        _panLastPos = event->pos();
+        event->accept();
+        return;
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void BackgroundWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (_panning && _tiledImage) {
+        // 拖动方向与图片移动方向一致
+        const QPoint delta = event->pos() - _panLastPos;
+        _panLastPos        = event->pos();
+        setViewCenter(_viewCenter - QPointF(delta) / tiledScale());
+        event->accept();
+        return;
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void BackgroundWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if (_panning && event->button() == Qt::LeftButton) {
+        _panning = false;
+        event->accept();
+        return;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void BackgroundWidget::wheelEvent(QWheelEvent *event) {
+    if (!_tiledImage || !_panZoomEnabled || event->angleDelta().y() == 0) {
+        QWidget::wheelEvent(event);
+        return;
+    }
+
+    // 每一格（120）缩放 1.25 倍，以光标位置为锚点
+    setZoom(_zoom * qPow(1.25, event->angleDelta().y() / 120.0), event->position());
+    event->accept();
+}
+
+// ========== 私有方法 ==========
+
+void BackgroundWidget::updateScaledPixmap(const QImage &prescaled) {
+    StatsScope scope(_stats);
+
+    // 本次缩放会覆盖所有被推迟的缩放，只有最后一次真正执行
+    if (_deferredRescales > 0) {
+        _coalescedRescales += _deferredRescales - 1;
+        _deferredRescales = 0;
+        _resizeIdleTimer->stop();
+    }
+
+    invalidateComposite();
+
+    // 动态背景的帧由后台按新尺寸重新缩放，完成前继续显示当前帧
+    if (_animation) {
+        _animation->setTarget(size(), toAspectRatioMode(_scaleMode), _scaleQuality, devicePixelRatioF());
+        return;
+    }
+
+    // 缓冲区已释放：由 restoreBuffers 在后台恢复，隐藏期间的尺寸变化不重新缩放
+    if (_trimmed) {
+        return;
+    }
+
+    if (_backgroundImage.isNull() || width() <= 0 || height() <= 0) {
+        _scaledBackground = QPixmap();
+        resetBlur();
+        resetKenBurnsPixmap();
+        return;
+    }
+
+    // 内存精简模式：确保已解码的分辨率与控件尺寸匹配
+    ensureDecodedResolution();
+
+    // 按物理像素缩放，绘制时不需要再次放大（每种设备像素比在缓存中各有一份）
+    const qreal dpr = devicePixelRatioF();
+
+    // 优先使用进程级缓存中的缩放结果（与缓存和其他控件共享同一份像素数据）
+    ImageCache   &cache  = ImageCache::instance();
+    const QString key    = scaledCacheKey(dpr);
+    QPixmap       pixmap = cache.findScaled(key);
+
+    // 缩放图片
+    if (pixmap.isNull()) {
+        QImage scaled;
+
+        // 目标尺寸始终按原图比例计算，从金字塔的哪一级开始缩放都得到相同尺寸
+        const QSize scaledSize = scaledTargetSize();
+
+        if (!prescaled.isNull() && prescaled.size() == scaledSize) {
+            // 已在后台预先缩放好
+            scaled = prescaled;
+        } else {
+            QImage source = _backgroundImage;
+
+            // 平滑缩小到一半以下时，从金字塔中不小于目标尺寸的最小一级开始
+            if (_scaleQuality != ScaleQuality_Nearest && _mipmapsEnabled && scaledSize.width() * 2 <= _backgroundImage.width() && scaledSize.height() * 2 <= _backgroundImage.height()) {
+                if (_mipPyramid) {
+                    source = _mipPyramid->levelFor(scaledSize);
+                } else {
+                    requestMipPyramid();
+                }
+            }
+
+            scaled = Resampler::scale(source, scaledSize, _scaleQuality);
+        }
+        // 插入缓存前设置设备像素比，之后再修改会使 QPixmap 深拷贝
+        pixmap = QPixmap::fromImage(std::move(scaled));
+        pixmap.setDevicePixelRatio(dpr);
+        cache.insertScaled(key, pixmap);
+        scheduleDiskCacheStore();
+    }
+    _scaledBackground = pixmap;
+    requestBlur();
+    requestKenBurnsPixmap();
+}
+
+QString BackgroundWidget::scaledCacheKey(const qreal devicePixelRatio) const {
+    if (_sourceKey.isEmpty() || !ImageCache::instance().isEnabled()) {
+        return {};
+    }
+    // 同一张图片按不同尺寸解码（内存精简模式、来自磁盘缓存）时缩放结果不同，按解码尺寸区分
+    return ImageCache::scaledKey(_sourceKey, size(), _scaleMode, _scaleQuality, devicePixelRatio, _backgroundImage.size());
+}
+
+QSize BackgroundWidget::scaledTargetSize() const {
+    return _backgroundImage.size().scaled(size() * devicePixelRatioF(), toAspectRatioMode(_scaleMode));
+}
+
+QSize BackgroundWidget::decodeBoundingSize() const {
+    if (!_downsampleOnDecode || !isVisible() || width() <= 0 || height() <= 0) {
+        return {};
+    }
+
+    // 向上取整到 128 像素，避免窗口每变大一点就重新解码
+    const qreal dpr     = devicePixelRatioF();
+    auto        roundUp = [](const int value) { return (value + 127) / 128 * 128; };
+    return {roundUp(qCeil(width() * dpr)), roundUp(qCeil(height() * dpr))};
+}
+
+void BackgroundWidget::ensureDecodedResolution() {
+    if ((!_downsampleOnDecode && !_displayResolution) || _sourcePath.isEmpty() || _redecodePending || !isVisible() || width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    // 未启用内存精简模式时为空，即按原尺寸解码
+    const QSize               bounds     = decodeBoundingSize();
+    const qreal               dpr        = devicePixelRatioF();
+    const Qt::AspectRatioMode decodeMode = toDecodeAspectMode(_scaleMode);
+
+    // 磁盘缓存中的缩放结果只要覆盖当前的缩放目标即可，与写入时的取整方式一致
+    const QSize required = _displayResolution ? _sourceSize.scaled(size() * dpr, toAspectRatioMode(_scaleMode))
+                                              : ImageLoader::decodeSize(_sourceSize, QSize(qCeil(width() * dpr), qCeil(height() * dpr)), decodeMode);
+
+    if (required.width() <= _backgroundImage.width() && required.height() <= _backgroundImage.height()) {
+        if (_displayResolution) {
+            return;
+        }
+
+        // 分辨率足够；如果远大于所需（例如显示前按原尺寸解码），缩小以释放内存
+        const QSize wanted = ImageLoader::decodeSize(_sourceSize, bounds, decodeMode);
+        if (static_cast<qint64>(_backgroundImage.width()) * _backgroundImage.height() >= 2 * static_cast<qint64>(wanted.width()) * wanted.height()) {
+            _backgroundImage = Resampler::scale(_backgroundImage, wanted, ScaleQuality_Area);
+            _mipPyramid.reset();
+        }
+        return;
+    }
+
+    // 控件变大超过已解码的分辨率，从源文件重新解码
+    qCDebug(lcMel) << "BackgroundWidget: 重新解码:" << _sourcePath << "已解码:" << _backgroundImage.size() << "需要:" << required;
+
+    if (_loadMode == LoadMode_Async) {
+        // 异步重新解码期间继续使用当前分辨率
+        const quint64 serial = _loadSerial;
+        _redecodePending     = true;
+        ++_pendingLoads;
+        ImageLoader::loadAsync(_sourcePath, bounds, decodeMode, this, [this, serial](const QImage &image, const QSize &sourceSize, const QString &) {
+            --_pendingLoads;
+            _redecodePending = false;
+            if (serial != _loadSerial || image.isNull()) {
+                return;
+            }
+            _backgroundImage   = image;
+            _sourceSize        = sourceSize;
+            _displayResolution = false;
+            _mipPyramid.reset();
+            updateScaledPixmap();
+            update();
+        });
+        return;
+    }
+
+    QSize        sourceSize;
+    const QImage image = ImageLoader::load(_sourcePath, bounds, decodeMode, &sourceSize);
+    if (!image.isNull()) {
+        _backgroundImage   = image;
+        _sourceSize        = sourceSize;
+        _displayResolution = false;
+        _mipPyramid.reset();
+    }
+}
+
+void BackgroundWidget::scheduleDiskCacheStore() {
+    if (_sourcePath.isEmpty() || _sourceKey.isEmpty() || _displayResolution || !DiskCache::instance().isEnabled()) {
+        return;
+    }
+
+    // 调整大小过程中的中间尺寸不写入，只保存停下来之后的结果
+    if (!_diskCacheTimer) {
+        _diskCacheTimer = new QTimer(this);
+        _diskCacheTimer->setSingleShot(true);
+        _diskCacheTimer->setInterval(kDiskCacheDelay);
+        connect(_diskCacheTimer, &QTimer::timeout, this, &BackgroundWidget::storeOnDiskCache);
+    }
+    _diskCacheTimer->start();
+}
+
+void BackgroundWidget::storeOnDiskCache() {
+    // 只写入从原图缩放出的、与当前尺寸和设备像素比一致的结果
+    const qreal dpr = devicePixelRatioF();
+    if (_sourcePath.isEmpty() || _sourceKey.isEmpty() || _displayResolution || _trimmed || _deferredRescales > 0 || _scaledBackground.isNull()
+        || !qFuzzyCompare(_scaledBackground.devicePixelRatio(), dpr)) {
+        return;
+    }
+
+    const QString key = ImageCache::scaledKey(_sourceKey, size(), _scaleMode, _scaleQuality, dpr);
+    ImageLoader::threadPool()->start([key, image = _scaledBackground.toImage(), sourceSize = _sourceSize]() {
+        DiskCache::instance().insertScaled(key, image, sourceSize);
+    });
+}
+
+void BackgroundWidget::requestMipPyramid() {
+    if (_mipBuildPending || _backgroundImage.isNull()) {
+        return;
+    }
+
+    _mipBuildPending   = true;
+    const QImage image = _backgroundImage;
+    runInBackground(
+            ImageLoader::threadPool(), this, [image]() { return std::make_shared<const MipPyramid>(image); },
+            [this, imageKey = image.cacheKey()](const std::shared_ptr<const MipPyramid> &pyramid) {
+                _mipBuildPending = false;
+                // 构建期间图片已更换，丢弃结果（下次缩放时重新构建）
+                if (!_mipmapsEnabled || imageKey != _backgroundImage.cacheKey()) {
+                    return;
+                }
+                _mipPyramid = pyramid;
+                qCDebug(lcMel) << "BackgroundWidget: 图片金字塔构建完成，级数:" << pyramid->levelCount() << "额外内存:" << pyramid->memoryBytes() << "字节";
+            });
+}
+
+QRect BackgroundWidget::calculateTargetRect(const QSize &imageSize) const {
+    const QSize target = imageSize.scaled(size(), toAspectRatioMode(_scaleMode));
+    return {QPoint((width() - target.width()) / 2, (height() - target.height()) / 2), target};
+}
+
+QRect BackgroundWidget::scaledPixmapRect(const QPixmap &pixmap) const {
+    if (_deferredRescales > 0) {
+        // 调整大小期间：上一次的缩放结果被拉伸到新的目标区域
+        return calculateTargetRect(pixmap.size());
+    }
+
+    // 居中（缩放结果与控件尺寸匹配，无需再次变换）；尺寸按缩放结果自身的设备像素比换算为逻辑像素
+    const qreal dpr = pixmap.devicePixelRatio();
+    const QSize logical(qRound(pixmap.width() / dpr), qRound(pixmap.height() / dpr));
+    return {QPoint((width() - logical.width()) / 2, (height() - logical.height()) / 2), logical};
+}
+
+void BackgroundWidget::paintExposedRect(QPainter &painter, const QRect &exposed) const {
+    const QRect area = exposed & rect();
+    if (area.isEmpty()) {
+        return;
+    }
+
+    // 过渡动画期间旧画面完全不透明地绘制在底层，新画面按过渡透明度叠加
+    const bool  transitioning = _transitionOpacity < 1.0 && !_oldFrame.isNull();
+    const qreal opacity       = transitioning ? _transitionOpacity : 1.0;
+    if (transitioning) {
+        drawFrame(painter, _oldFrame, area);
+    }
+
+    // 稳定状态：贴一次合成缓存
+    if (!_composite.isNull() && _deferredRescales == 0) {
+        painter.setOpacity(opacity);
+        drawFrame(painter, _composite, area);
+        painter.setOpacity(1.0);
+        return;
+    }
+
+    paintLayers(painter, area, opacity);
+}
+
+void BackgroundWidget::paintLayers(QPainter &painter, const QRect &exposed, const qreal opacity) const {
+    for (const BackgroundLayer &layer : getEffectiveLayers()) {
+        if (!layer.isVisible() || layer.getOpacity() <= 0.0) {
+            continue;
+        }
+
+        painter.setOpacity(opacity * layer.getOpacity());
+        painter.setCompositionMode(layer.getBlendMode());
+
+        switch (layer.getType()) {
+            case LayerType_Image:
+                if (_tiledImage) {
+                    drawTiles(painter, exposed);
+                } else if (_animation) {
+                    // 计入动态背景每帧的耗时
+                    QElapsedTimer timer;
+                    timer.start();
+                    drawScaledPixmap(painter, _scaledBackground, exposed);
+                    _animation->addPaintTime(timer.nsecsElapsed());
+                } else if (_scaledBackground.isNull() && !_placeholder.isNull()) {
+                    // 缓冲区已释放、后台恢复尚未完成：拉伸绘制占位缩略图
+                    drawStretchedPixmap(painter, _placeholder, calculateTargetRect(_placeholder.size()), exposed);
+                } else if (isKenBurnsReady()) {
+                    drawKenBurns(painter, exposed);
+                } else if (_blurRadius > 0 && !_blurredBackground.isNull()) {
+                    drawBlurredPixmap(painter, exposed);
+                } else {
+                    drawScaledPixmap(painter, _scaledBackground, exposed);
+                }
+                break;
+            case LayerType_Solid:
+            case LayerType_Gradient:
+                painter.fillRect(exposed, layer.getBrush());
+                break;
+            case LayerType_Overlay: {
+                // 叠加图片拉伸覆盖整个控件，只取暴露区域对应的部分
+                const QImage &image = layer.getImage();
+                if (!image.isNull()) {
+                    const qreal  sx = static_cast<qreal>(image.width()) / width();
+                    const qreal  sy = static_cast<qreal>(image.height()) / height();
+                    const QRectF source(exposed.x() * sx, exposed.y() * sy, exposed.width() * sx, exposed.height() * sy);
+                    painter.drawImage(QRectF(exposed), image, source);
+                }
+                break;
+            }
+        }
+    }
+
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.setOpacity(1.0);
+}
+
+void BackgroundWidget::drawFrame(QPainter &painter, const QPixmap &frame, const QRect &exposed) const {
+    // 与控件等大（按画面自身的设备像素比）：直接取源图中对应的物理像素区域
+    const qreal dpr = frame.devicePixelRatio();
+    if (frame.size() == size() * dpr) {
+        painter.drawPixmap(QPointF(exposed.topLeft()), frame, QRectF(exposed.x() * dpr, exposed.y() * dpr, exposed.width() * dpr, exposed.height() * dpr));
+        return;
+    }
+
+    // 画面与控件尺寸不同（调整大小期间）时拉伸绘制
+    const qreal  sx = static_cast<qreal>(frame.width()) / width();
+    const qreal  sy = static_cast<qreal>(frame.height()) / height();
+    const QRectF source(exposed.x() * sx, exposed.y() * sy, exposed.width() * sx, exposed.height() * sy);
+    painter.drawPixmap(QRectF(exposed), frame, source);
+}
+
+void BackgroundWidget::invalidateComposite() {
+    _composite      = QPixmap();
+    _compositeDirty = true;
+}
+
+void BackgroundWidget::rebuildComposite() {
+    _compositeDirty = false;
+    _composite      = QPixmap();
+
+    const QList<BackgroundLayer> layers = getEffectiveLayers();
+    if (layers.isEmpty() || width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    // 分块模式随平移和缩放变化、动态背景和平移缩放逐帧变化，逐层绘制即可，不缓存整个画面
+    if (_tiledImage || _animation || _kenBurnsEnabled) {
+        return;
+    }
+
+    // 只有一个普通图片层时直接绘制缩放结果即可，不需要额外的缓存
+    const BackgroundLayer &bottom = layers.first();
+    if (layers.size() == 1 && bottom.getType() == LayerType_Image && bottom.isVisible() && bottom.getOpacity() >= 1.0 && bottom.getBlendMode() == QPainter::CompositionMode_SourceOver) {
+        return;
+    }
+
+    // 底层完全覆盖控件时生成不透明的缓存（贴图时无需混合）
+    bool opaque = bottom.isOpaque();
+    if (bottom.getType() == LayerType_Image && bottom.isVisible() && bottom.getOpacity() >= 1.0) {
+        opaque = !_scaledBackground.isNull() && !_scaledBackground.hasAlphaChannel() && _scaleMode != ScaleMode_Fit;
+    }
+
+    _composite = renderLayers(opaque);
+}
+
+QPixmap BackgroundWidget::renderLayers(const bool opaque) const {
+    if (width() <= 0 || height() <= 0) {
+        return {};
+    }
+
+    // 合成缓存与缩放结果一样按物理像素生成，绘制坐标仍为逻辑像素
+    const qreal dpr = devicePixelRatioF();
+    QImage      frame(size() * dpr, opaque ? QImage::Format_RGB32 : QImage::Format_ARGB32_Premultiplied);
+    frame.setDevicePixelRatio(dpr);
+    frame.fill(opaque ? Qt::black : Qt::transparent);
+
+    QPainter painter(&frame);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    paintLayers(painter, rect(), 1.0);
+    painter.end();
+
+    return QPixmap::fromImage(frame);
+}
+
+QPixmap BackgroundWidget::currentFrame() const {
+    if (!_compositeDirty && !_composite.isNull() && _deferredRescales == 0) {
+        return _composite;
+    }
+    return renderLayers(false);
+}
+
+void BackgroundWidget::drawScaledPixmap(QPainter &painter, const QPixmap &pixmap, const QRect &exposed) const {
+    if (pixmap.isNull()) {
+        return;
+    }
+
+    const QRect target  = scaledPixmapRect(pixmap);
+    const QRect visible = target & exposed;
+    if (visible.isEmpty()) {
+        return;
+    }
+
+    if (_deferredRescales > 0) {
+        // 调整大小期间：按拉伸比例映射回源图中对应的区域（快速变换，空闲后再高质量缩放）
+        const qreal  sx = static_cast<qreal>(pixmap.width()) / target.width();
+        const qreal  sy = static_cast<qreal>(pixmap.height()) / target.height();
+        const QRectF source((visible.x() - target.x()) * sx, (visible.y() - target.y()) * sy, visible.width() * sx, visible.height() * sy);
+        painter.save();
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+        painter.drawPixmap(QRectF(visible), pixmap, source);
+        painter.restore();
+        return;
+    }
+
+    // 原尺寸绘制源图中对应的区域（源区域为物理像素）
+    const qreal dpr    = pixmap.devicePixelRatio();
+    const QRect source = visible.translated(-target.topLeft());
+    painter.drawPixmap(QPointF(visible.topLeft()), pixmap, QRectF(source.x() * dpr, source.y() * dpr, source.width() * dpr, source.height() * dpr));
+}
+
+void BackgroundWidget::drawStretchedPixmap(QPainter &painter, const QPixmap &pixmap, const QRect &target, const QRect &exposed) const {
+    const QRect visible = target & exposed;
+    if (visible.isEmpty()) {
+        return;
+    }
+
+    const qreal sx = static_cast<qreal>(pixmap.width()) / target.width();
+    const qreal sy = static_cast<qreal>(pixmap.height()) / target.height();
+    painter.drawPixmap(QRectF(visible), pixmap, QRectF((visible.x() - target.x()) * sx, (visible.y() - target.y()) * sy, visible.width() * sx, visible.height() * sy));
+}
+
+void BackgroundWidget::drawBlurredPixmap(QPainter &painter, const QRect &exposed) const {
+    // 与当前缩放结果对应：与不模糊时一样直接贴图
+    if (_blurSourceKey == _scaledBackground.cacheKey()) {
+        drawScaledPixmap(painter, _blurredBackground, exposed);
+        return;
+    }
+
+    // 同一张图片在尺寸、设备像素比或半径变化后重新模糊：模糊后的画面拉伸后看不出差别
+    if (_blurImageKey == _backgroundImage.cacheKey() && !_scaledBackground.isNull()) {
+        drawStretchedPixmap(painter, _blurredBackground, scaledPixmapRect(_scaledBackground), exposed);
+        return;
+    }
+
+    drawScaledPixmap(painter, _scaledBackground, exposed);
+}
+
+void BackgroundWidget::drawKenBurns(QPainter &painter, const QRect &exposed) const {
+    // 暴露区域按比例映射到源矩形中（亚像素位置由双线性过滤平滑）
+    const QRectF source = kenBurnsSourceRect();
+    const qreal  sx     = source.width() / width();
+    const qreal  sy     = source.height() / height();
+    painter.drawPixmap(QRectF(exposed), _kenBurnsPixmap, QRectF(source.x() + exposed.x() * sx, source.y() + exposed.y() * sy, exposed.width() * sx, exposed.height() * sy));
+}
+
+void BackgroundWidget::drawTiles(QPainter &painter, const QRect &exposed) const {
+    const QSize imageSize = _tiledImage->getSize();
+    const qreal scale     = tiledScale();
+
+    // 控件坐标 = origin + 原图坐标 * scale
+    const QPointF origin = QPointF(width() / 2.0, height() / 2.0) - _viewCenter * scale;
+
+    // 暴露区域映射回原图
+    const QRectF imageBounds(QPointF(0, 0), QSizeF(imageSize));
+    const QRectF visible = QRectF((exposed.x() - origin.x()) / scale, (exposed.y() - origin.y()) / scale, exposed.width() / scale, exposed.height() / scale) & imageBounds;
+    if (visible.isEmpty()) {
+        return;
+    }
+
+    const QImage overview = _tiledImage->getOverview();
+
+    // 按物理像素选择级别：分块像素不少于屏幕像素；整级解码超出内存上限时改用更粗的一级
+    const int level = _tiledImage->usableLevel(_tiledImage->levelForScale(scale * devicePixelRatioF()));
+    if (level < 0) {
+        // 任何一级都无法在上限内解码：只显示概览图
+        painter.drawImage(QRectF(origin, QSizeF(imageSize) * scale), overview);
+        return;
+    }
+
+    const int   factor = 1 << level;
+    const int   span   = TiledImage::TileSize * factor; // 一个分块覆盖的原图像素
+    const QSize grid   = _tiledImage->gridSize(level);
+
+    const int firstColumn = qMax(0, qFloor(visible.left() / span));
+    const int lastColumn  = qMin(grid.width() - 1, qCeil(visible.right() / span) - 1);
+    const int firstRow    = qMax(0, qFloor(visible.top() / span));
+    const int lastRow     = qMin(grid.height() - 1, qCeil(visible.bottom() / span) - 1);
+
+    const qreal ox = static_cast<qreal>(overview.width()) / imageSize.width();
+    const qreal oy = static_cast<qreal>(overview.height()) / imageSize.height();
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            // 分块在原图中的区域
+            const QRect levelRect = _tiledImage->tileRect(level, column, row);
+            const QRect source    = QRect(levelRect.x() * factor, levelRect.y() * factor, levelRect.width() * factor, levelRect.height() * factor) & imageBounds.toRect();
+
+            // 边缘按同一规则取整，相邻分块之间没有缝隙
+            const int   left   = qRound(origin.x() + source.left() * scale);
+            const int   top    = qRound(origin.y() + source.top() * scale);
+            const int   right  = qRound(origin.x() + (source.left() + source.width()) * scale);
+            const int   bottom = qRound(origin.y() + (source.top() + source.height()) * scale);
+            const QRect target(left, top, right - left, bottom - top);
+            if (!target.intersects(exposed)) {
+                continue;
+            }
+
+            const QImage tile = _tiledImage->tile(level, column, row);
+            if (!tile.isNull()) {
+                painter.drawImage(target, tile);
+            } else if (!overview.isNull()) {
+                // 分块尚未就绪：用概览图中对应的区域代替
+                painter.drawImage(QRectF(target), overview, QRectF(source.x() * ox, source.y() * oy, source.width() * ox, source.height() * oy));
+            }
+        }
+    }
 }
 
 void BackgroundWidget::drawDefaultBackground(QPainter &painter) const {
@@ -7,12 +7,28 @@
 #define MEL_BACKGROUNDWIDGET_H
 
 #include "Mel_export.h"
+#include "AnimatedBackground.h"
+#include "BackgroundLayer.h"
+#include "TransitionDriver.h"
+#include "core/Stats.h"
+#include "image/Resampler.h"
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QPointer>
 #include <QWidget>
+#include <functional>
+#include <memory>
 
 class QPropertyAnimation;
+class QTimer;
+class QWindow;
 
 namespace Mel {
 
+class MipPyramid;
+class TiledImage;
+
 /**
  * @brief 背景图片缩放模式
  */
@@ -22,6 +38,41 @@ enum BackgroundScaleMode {
     ScaleMode_Stretch = 2  // 拉伸填充（忽略比例，可能变形）
 };
 
+/**
+ * @brief 背景图片加载模式
+ */
+enum BackgroundLoadMode {
+    LoadMode_Sync  = 0, // 同步加载（在主线程解码，返回时已完成）
+    LoadMode_Async = 1  // 异步加载（在线程池解码，完成后再启动过渡动画）
+};
+
+/**
+ * @brief 隐藏或最小化时释放像素缓冲区的策略
+ */
+enum BackgroundTrimPolicy {
+    TrimPolicy_None   = 0, // 不释放（默认）
+    TrimPolicy_Scaled = 1, // 释放缩放结果、过渡动画的旧画面、合成缓存和图片金字塔
+    TrimPolicy_All    = 2  // 同时释放原始图片及其在 ImageCache 中的条目（只保留来源路径，无法重新读取时保留原图）
+};
+
+/**
+ * @brief 预先准备好的背景图片（后台解码并按控件尺寸缩放的结果）
+ *
+ * 由 BackgroundWidget::prepareBackground 生成，交给 setPreparedBackground 后切换时无需再解码和缩放
+ */
+struct PreparedBackground {
+    QString             path;                             // 图片路径
+    QImage              image;                            // 解码结果（失败时为空）
+    QSize               sourceSize;                       // 原始图片尺寸
+    QImage              scaled;                           // 按准备时的控件尺寸缩放的结果
+    QSize               widgetSize;                       // 准备时的控件尺寸
+    qreal               devicePixelRatio = 1.0;           // 准备时的设备像素比（scaled 按物理像素缩放）
+    BackgroundScaleMode scaleMode    = ScaleMode_Fill;    // 准备时的缩放模式
+    ScaleQuality        scaleQuality = ScaleQuality_Area; // 准备时的缩放质量
+    QString             errorString;                      // 错误信息
+    bool                fromDiskCache = false;            // image 是否为磁盘缓存中的缩放结果（只有准备时的显示分辨率）
+};
+
 /**
  * @brief 背景图片控件
  *
@@ -30,6 +81,20 @@ enum BackgroundScaleMode {
  * - 自动缩放以适应控件大小
  * - 多种缩放模式（填满/适应/拉伸）
  * - 支持背景色和遮罩
+ * - 支持在后台线程异步解码图片
+ * - 拖动调整大小时快速拉伸旧图，空闲后再高质量重新缩放
+ * - 可按显示尺寸解码图片，不保留全分辨率原图
+ * - 解码和缩放结果通过 ImageCache 在多个控件之间共享
+ * - 使用图片金字塔加速平滑缩放
+ * - 只重绘暴露区域，子控件的局部更新不会重新混合整张背景
+ * - 图层栈（图片/纯色/渐变/叠加图片）合成为一张缓存，稳定状态下每次绘制只需一次贴图
+ * - 超大图片按分块解码和绘制，支持平移和缩放
+ * - 动态背景（GIF/APNG/WebP），不可见时停止播放
+ * - 隐藏或窗口最小化时可释放像素缓冲区，重新显示时在后台恢复
+ * - 按物理像素缩放（高分屏不再二次放大），切换屏幕时在后台重新缩放
+ * - 平移缩放（Ken Burns）动画：只预先缩放一次，每帧移动源矩形
+ * - 毛玻璃模糊：每张缩放结果在后台模糊一次并缓存，绘制开销与不模糊时相同
+ * - 参与全局像素内存预算（MelLib::setPixelMemoryBudget），超出时最久未绘制的控件先释放缓冲区
  */
 class MEL_EXPORT BackgroundWidget : public QWidget {
     Q_OBJECT
@@ -42,8 +107,11 @@ public:
 
     /**
      * @brief 设置背景图片（从文件路径或资源路径）
+     * 启用 DiskCache 时先按当前尺寸和缩放设置查找磁盘缓存，命中时直接映射缩放好的结果而不解码，
+     * 需要更高分辨率时（例如控件变大）再从源文件解码。控件显示之前尺寸还不确定，不查找磁盘缓存而照常解码，
+     * 显示后按最终尺寸缩放的结果再写入磁盘缓存
      * @param path 图片路径（支持 :/ 资源路径）
-     * @return 是否加载成功
+     * @return 同步模式下返回是否加载成功；异步模式下始终返回 true，结果通过 backgroundLoaded/loadFailed 信号通知
      */
     bool setBackgroundImage(const QString &path);
 
@@ -53,6 +121,38 @@ public:
      */
     void setBackgroundPixmap(const QPixmap &pixmap);
 
+    /**
+     * @brief 在后台线程中预先解码并按当前控件尺寸、缩放模式和缩放质量缩放图片（不改变当前背景）
+     * @param path 图片路径（支持 :/ 资源路径）
+     * @param receiver 接收者（被销毁时不再回调）
+     * @param callback 完成回调（在主线程中调用）
+     */
+    void prepareBackground(const QString &path, QObject *receiver, std::function<void(const PreparedBackground &)> callback) const;
+
+    /**
+     * @brief 在后台线程中把已准备的图片按当前控件尺寸、缩放模式和缩放质量重新缩放（复用解码结果，不改变当前背景）
+     *
+     * 用于控件尺寸或缩放设置在准备之后发生了变化的情况；来自磁盘缓存的结果分辨率不足，改为重新准备
+     * @param prepared 之前 prepareBackground 的结果
+     * @param receiver 接收者（被销毁时不再回调）
+     * @param callback 完成回调（在主线程中调用）
+     */
+    void rescalePrepared(const PreparedBackground &prepared, QObject *receiver, std::function<void(const PreparedBackground &)> callback) const;
+
+    /**
+     * @brief 使用预先准备好的图片设置背景（启动过渡动画）
+     *
+     * 控件尺寸和缩放设置与准备时一致时直接使用预先缩放的结果，否则从解码结果重新缩放
+     * @param prepared prepareBackground 的结果
+     * @return 是否设置成功（解码失败时发出 loadFailed 信号并返回 false）
+     */
+    bool setPreparedBackground(const PreparedBackground &prepared);
+
+    /**
+     * @brief 预先缩放的结果是否与当前控件尺寸和缩放设置一致
+     */
+    [[nodiscard]] bool isPreparedFor(const PreparedBackground &prepared) const;
+
     /**
      * @brief 清除背景图片
      */
@@ -62,12 +162,70 @@ public:
      * @brief 获取当前背景图片
      * @return 背景图片（可能为空）
      */
-    [[nodiscard]] QPixmap getBackgroundPixmap() const { return _backgroundImage; }
+    [[nodiscard]] QPixmap getBackgroundPixmap() const;
+
+    /**
+     * @brief 获取当前背景图片（原始解码数据，按显示尺寸解码时可能小于原图）
+     * @return 背景图片（可能为空）
+     */
+    [[nodiscard]] QImage getBackgroundImage() const { return _backgroundImage; }
+
+    /**
+     * @brief 获取背景图片的原始尺寸（未缩小前）
+     */
+    [[nodiscard]] QSize getSourceSize() const { return _sourceSize; }
 
     /**
      * @brief 背景图片是否为空
      */
-    [[nodiscard]] bool isBackgroundEmpty() const { return _backgroundImage.isNull(); }
+    [[nodiscard]] bool isBackgroundEmpty() const { return _backgroundImage.isNull() && !_tiledImage && !_animation; }
+
+    // ========== 加载模式 ==========
+
+    /**
+     * @brief 设置图片加载模式
+     * @param mode 加载模式（默认同步）
+     */
+    void setLoadMode(BackgroundLoadMode mode) { _loadMode = mode; }
+
+    /**
+     * @brief 获取图片加载模式
+     */
+    [[nodiscard]] BackgroundLoadMode getLoadMode() const { return _loadMode; }
+
+    /**
+     * @brief 是否有正在进行的异步加载
+     */
+    [[nodiscard]] bool isLoading() const { return _pendingLoads > 0; }
+
+    /**
+     * @brief 设置是否按显示尺寸解码（内存精简模式）
+     *
+     * 启用后通过 QImageReader::setScaledSize 直接解码到当前控件尺寸（考虑设备像素比和缩放模式）所需的分辨率，
+     * 不再保留全分辨率原图；控件变大超过已解码的分辨率时会自动重新解码。仅对 setBackgroundImage 设置的图片生效
+     * @param enabled true=按显示尺寸解码，false=解码完整原图（默认）
+     */
+    void setDownsampleOnDecode(bool enabled);
+
+    /**
+     * @brief 是否按显示尺寸解码
+     */
+    [[nodiscard]] bool isDownsampleOnDecode() const { return _downsampleOnDecode; }
+
+    /**
+     * @brief 设置是否渐进加载
+     *
+     * 启用后异步加载期间先拉伸显示图片的极小预览（ImagePreview），完整图片就绪后通过切换动画交叉淡入；
+     * 没有预览的图片在解码完成后于后台生成预览，供之后的加载使用。只在还没有显示任何画面时显示预览，
+     * 已有背景时仍从当前画面过渡。仅对异步模式下 setBackgroundImage 设置的图片生效
+     * @param enabled true=渐进加载，false=加载完成前不显示（默认）
+     */
+    void setProgressiveLoading(bool enabled);
+
+    /**
+     * @brief 是否渐进加载
+     */
+    [[nodiscard]] bool isProgressiveLoading() const { return _progressiveLoading; }
 
     // ========== 缩放模式 ==========
 
@@ -111,18 +269,351 @@ public:
      */
     [[nodiscard]] bool hasOverlay() const { return _overlayColor.isValid() && _overlayColor.alpha() > 0; }
 
+    // ========== 图层 ==========
+
+    /**
+     * @brief 设置图层栈（从下到上绘制）
+     *
+     * 设置后图层栈完全取代背景色和遮罩（setBackgroundColor/setOverlayColor）组成的默认图层；
+     * 图层或控件尺寸变化时重新合成一次，之后每次绘制只需贴一张合成缓存
+     * @param layers 图层列表，背景图片通过 BackgroundLayer::image() 放入
+     */
+    void setLayers(const QList<BackgroundLayer> &layers);
+
+    /**
+     * @brief 在图层栈顶部添加一个图层
+     *
+     * 当前没有自定义图层时，会先以默认图层（背景色、图片、遮罩）作为图层栈
+     */
+    void addLayer(const BackgroundLayer &layer);
+
+    /**
+     * @brief 清除自定义图层，恢复由背景色、图片和遮罩组成的默认图层
+     */
+    void clearLayers();
+
+    /**
+     * @brief 获取自定义图层（未设置时为空）
+     */
+    [[nodiscard]] QList<BackgroundLayer> getLayers() const { return _layers; }
+
+    /**
+     * @brief 获取实际绘制的图层（自定义图层，或由背景色、图片和遮罩组成的默认图层）
+     */
+    [[nodiscard]] QList<BackgroundLayer> getEffectiveLayers() const;
+
+    // ========== 分块图片 ==========
+
+    /**
+     * @brief 以分块方式设置超大背景图片（8K 照片、全景图等）
+     *
+     * 不解码整张图片：只按当前缩放比例在后台解码与可见区域相交的分块，
+     * 分块缓存不超过 setTileMemoryLimit 设置的上限。未就绪的分块先用概览图代替。
+     * 分块模式下拉伸模式按填满处理；设置普通背景图片或清除背景时退出分块模式
+     * @param path 图片路径
+     * @return 是否成功（只读取文件头和概览图）
+     */
+    bool setTiledBackground(const QString &path);
+
+    /**
+     * @brief 是否处于分块模式
+     */
+    [[nodiscard]] bool isTiled() const { return _tiledImage != nullptr; }
+
+    /**
+     * @brief 获取当前的分块图片（非分块模式时为空）
+     */
+    [[nodiscard]] TiledImage *getTiledImage() const { return _tiledImage; }
+
+    /**
+     * @brief 设置分块缓存的内存上限（应不小于可见区域所需的分块）
+     * @param bytes 字节数，默认128MB
+     */
+    void setTileMemoryLimit(qint64 bytes);
+
+    /**
+     * @brief 获取分块缓存的内存上限（字节）
+     */
+    [[nodiscard]] qint64 getTileMemoryLimit() const { return _tileMemoryLimit; }
+
+    /**
+     * @brief 设置分块模式的缩放倍数（1.0 为按缩放模式完整显示）
+     * @param zoom 缩放倍数，限制在 1.0 到原图 4 倍像素之间
+     * @param anchor 保持不动的控件坐标（为空时以控件中心为准）
+     */
+    void setZoom(qreal zoom, const QPointF &anchor = QPointF());
+
+    /**
+     * @brief 获取分块模式的缩放倍数
+     */
+    [[nodiscard]] qreal getZoom() const { return _zoom; }
+
+    /**
+     * @brief 设置控件中心对应的原图坐标（平移）
+     */
+    void setViewCenter(const QPointF &center);
+
+    /**
+     * @brief 获取控件中心对应的原图坐标
+     */
+    [[nodiscard]] QPointF getViewCenter() const { return _viewCenter; }
+
+    /**
+     * @brief 设置是否允许用鼠标拖动平移、滚轮缩放（仅分块模式，默认开启）
+     */
+    void setPanZoomEnabled(bool enabled) { _panZoomEnabled = enabled; }
+
+    /**
+     * @brief 是否允许鼠标平移和缩放
+     */
+    [[nodiscard]] bool isPanZoomEnabled() const { return _panZoomEnabled; }
+
+    // ========== 动态背景 ==========
+
+    /**
+     * @brief 设置动态背景（GIF/APNG/WebP 等多帧图片）
+     *
+     * 每一帧只在后台按控件尺寸缩放一次，缩放结果保存在 setAnimationCacheLimit 限制的环形缓存中；
+     * 控件隐藏、被遮挡或窗口最小化时停止播放。设置普通背景图片或清除背景时退出动态背景
+     * @param path 图片路径
+     * @return 是否成功（第一帧在后台解码，显示后发出 backgroundLoaded）
+     */
+    bool setAnimatedBackground(const QString &path);
+
+    /**
+     * @brief 是否正在显示动态背景
+     */
+    [[nodiscard]] bool isAnimated() const { return _animation != nullptr; }
+
+    /**
+     * @brief 获取当前的动态背景（非动态背景时为空）
+     */
+    [[nodiscard]] AnimatedBackground *getAnimation() const { return _animation; }
+
+    /**
+     * @brief 设置动态背景帧缓存的内存上限
+     * @param bytes 字节数，默认64MB
+     */
+    void setAnimationCacheLimit(qint64 bytes);
+
+    /**
+     * @brief 获取动态背景帧缓存的内存上限（字节）
+     */
+    [[nodiscard]] qint64 getAnimationCacheLimit() const { return _animationCacheLimit; }
+
+    /**
+     * @brief 获取动态背景的播放统计（含每帧平均耗时）
+     */
+    [[nodiscard]] AnimationStats getAnimationStats() const;
+
+    // ========== 毛玻璃 ==========
+
+    /**
+     * @brief 设置毛玻璃模糊半径
+     *
+     * 每张缩放结果只在后台线程模糊一次，模糊结果与缩放结果一起缓存，稳定状态下的绘制开销与不模糊时相同；
+     * 模糊完成前先绘制清晰的图片（尺寸变化后重新模糊期间拉伸绘制上一次的模糊结果）。分块图片和动态背景不模糊
+     * @param radius 模糊半径（逻辑像素，按设备像素比换算为物理像素），0 表示不模糊（默认）
+     */
+    void setBlurRadius(int radius);
+
+    /**
+     * @brief 获取毛玻璃模糊半径（逻辑像素）
+     */
+    [[nodiscard]] int getBlurRadius() const { return _blurRadius; }
+
+    /**
+     * @brief 当前缩放结果的模糊结果是否已就绪
+     */
+    [[nodiscard]] bool isBlurReady() const;
+
+    // ========== 平移缩放（Ken Burns） ==========
+
+    /**
+     * @brief 启用或禁用缓慢平移缩放的背景动画（适用于展示屏和待机画面）
+     *
+     * 在后台把图片缩放一次到控件尺寸的 getKenBurnsZoom() 倍，之后每帧只移动源矩形并用双线性过滤贴图，
+     * 不会逐帧重新缩放，CPU 和内存占用不随运行时间增长。动画在 kenBurnsProgress 属性上循环推进，
+     * 也可以停用内置动画后用 QPropertyAnimation 驱动该属性。始终按填满方式显示；
+     * 控件隐藏或窗口最小化时暂停。分块图片和动态背景不参与
+     */
+    void setKenBurnsEnabled(bool enabled);
+
+    /**
+     * @brief 是否启用平移缩放动画
+     */
+    [[nodiscard]] bool isKenBurnsEnabled() const { return _kenBurnsEnabled; }
+
+    /**
+     * @brief 设置一个往返周期的时长
+     * @param msec 毫秒，默认30000；0 表示停用内置动画（由外部驱动 kenBurnsProgress）
+     */
+    void setKenBurnsDuration(int msec);
+
+    /**
+     * @brief 获取一个往返周期的时长（毫秒）
+     */
+    [[nodiscard]] int getKenBurnsDuration() const { return _kenBurnsDuration; }
+
+    /**
+     * @brief 设置最大放大倍数（预先缩放的图片相对控件的尺寸）
+     * @param zoom 1.0-2.0，默认1.2
+     */
+    void setKenBurnsZoom(qreal zoom);
+
+    /**
+     * @brief 获取最大放大倍数
+     */
+    [[nodiscard]] qreal getKenBurnsZoom() const { return _kenBurnsZoom; }
+
+    /**
+     * @brief 设置移动路径：从完全缩小时的焦点移动到完全放大时的焦点
+     * @param from 起点（相对可移动范围，(0, 0) 为左上，(1, 1) 为右下），默认 (0.3, 0.4)
+     * @param to 终点，默认 (0.7, 0.6)
+     */
+    void setKenBurnsPath(const QPointF &from, const QPointF &to);
+
+    /**
+     * @brief 设置平移缩放进度（0 到 1 为一个往返周期：0 完全缩小，0.5 完全放大）
+     */
+    void setKenBurnsProgress(qreal progress);
+
+    /**
+     * @brief 获取平移缩放进度
+     */
+    [[nodiscard]] qreal getKenBurnsProgress() const { return _kenBurnsProgress; }
+
+    // ========== 内存释放 ==========
+
+    /**
+     * @brief 设置隐藏或窗口最小化时释放像素缓冲区的策略
+     *
+     * 控件隐藏或所在窗口最小化超过 setTrimDelay 设置的时长后释放缓冲区，只保留一张很小的占位缩略图；
+     * 重新显示时先拉伸绘制占位图，同时在后台重新解码和缩放，完成后替换。
+     * 分块图片和动态背景只清空分块/帧缓存
+     * @param policy 释放策略（默认不释放）
+     */
+    void setTrimPolicy(BackgroundTrimPolicy policy);
+
+    /**
+     * @brief 获取释放策略
+     */
+    [[nodiscard]] BackgroundTrimPolicy getTrimPolicy() const { return _trimPolicy; }
+
+    /**
+     * @brief 设置隐藏或最小化后多久释放缓冲区
+     * @param msec 延迟（毫秒），默认2000，设为0时立即释放
+     */
+    void setTrimDelay(int msec);
+
+    /**
+     * @brief 获取释放延迟（毫秒）
+     */
+    [[nodiscard]] int getTrimDelay() const;
+
+    /**
+     * @brief 缓冲区是否已被释放（正在显示占位图或等待恢复）
+     */
+    [[nodiscard]] bool isTrimmed() const { return _trimmed; }
+
+    /**
+     * @brief 释放可重新生成的缓冲区（由 PixelBudget 在超出全局像素内存预算时调用）
+     *
+     * 隐藏或最小化时按 TrimPolicy_All 释放，重新显示时在后台恢复；
+     * 可见时只释放图片金字塔和合成缓存，绘制所需的缩放结果保留
+     * @return 释放的字节数
+     */
+    qint64 releaseDerivableBuffers();
+
+    // ========== 运行时统计 ==========
+
+    /**
+     * @brief 获取本控件的统计：解码、缩放和每帧绘制耗时，过渡动画帧数，持有的像素字节数
+     *
+     * 所有控件的合计见 Stats::instance().globalSnapshot()
+     */
+    [[nodiscard]] StatsSnapshot getStats() const;
+
+    /**
+     * @brief 获取本控件持有的像素缓冲区字节数（原图、缩放结果、旧画面、合成缓存、金字塔、分块和帧缓存；
+     * 与 ImageCache 共享的数据也计入）
+     */
+    [[nodiscard]] qint64 getPixelMemoryBytes() const;
+
     // ========== 高级选项 ==========
 
     /**
      * @brief 设置是否使用平滑变换（高质量但慢）
+     *
+     * 等同于 setScaleQuality(smooth ? ScaleQuality_Area : ScaleQuality_Nearest)
      * @param smooth true=平滑，false=快速
      */
     void setSmoothTransformation(bool smooth);
 
     /**
-     * @brief 是否使用平滑变换
+     * @brief 是否使用平滑变换（缩放质量不是最近邻）
+     */
+    [[nodiscard]] bool isSmoothTransformation() const { return _scaleQuality != ScaleQuality_Nearest; }
+
+    /**
+     * @brief 设置缩放质量（使用多线程 SIMD 重采样器 Resampler）
+     * @param quality 缩放质量（默认区域平均）
      */
-    [[nodiscard]] bool isSmoothTransformation() const { return _smoothTransformation; }
+    void setScaleQuality(ScaleQuality quality);
+
+    /**
+     * @brief 获取缩放质量
+     */
+    [[nodiscard]] ScaleQuality getScaleQuality() const { return _scaleQuality; }
+
+    /**
+     * @brief 设置是否使用图片金字塔加速平滑缩放
+     *
+     * 启用后，首次需要缩小到一半以下时在后台线程构建金字塔（1/2、1/4 ...），
+     * 之后的平滑缩放从不小于目标尺寸的最小一级开始，而不是每次都从原图开始
+     * @param enabled true=启用（默认），false=始终从原图缩放
+     */
+    void setMipmapsEnabled(bool enabled);
+
+    /**
+     * @brief 是否使用图片金字塔
+     */
+    [[nodiscard]] bool isMipmapsEnabled() const { return _mipmapsEnabled; }
+
+    /**
+     * @brief 获取图片金字塔额外占用的内存（字节，不含原图）
+     */
+    [[nodiscard]] qint64 getMipmapMemoryBytes() const;
+
+    /**
+     * @brief 设置是否启用交互式调整大小
+     *
+     * 启用后，连续的 resize 事件不会立即重新缩放，而是把上一次的缩放结果直接拉伸绘制，
+     * 等到调整大小停止（空闲超时）后再执行一次高质量缩放
+     * @param enabled true=启用（默认），false=每次 resize 都立即重新缩放
+     */
+    void setInteractiveResize(bool enabled);
+
+    /**
+     * @brief 是否启用交互式调整大小
+     */
+    [[nodiscard]] bool isInteractiveResize() const { return _interactiveResize; }
+
+    /**
+     * @brief 设置调整大小的空闲超时
+     * @param msec 最后一次 resize 后等待多久执行高质量缩放（毫秒），默认150
+     */
+    void setResizeIdleTimeout(int msec);
+
+    /**
+     * @brief 获取调整大小的空闲超时（毫秒）
+     */
+    [[nodiscard]] int getResizeIdleTimeout() const;
+
+    /**
+     * @brief 获取累计被合并（省略）的缩放次数
+     */
+    [[nodiscard]] int getCoalescedRescaleCount() const { return _coalescedRescales; }
 
     // ========== 动画设置 ==========
 
@@ -137,6 +628,16 @@ public:
      */
     [[nodiscard]] int getTransitionDuration() const { return _transitionDuration; }
 
+    /**
+     * @brief 是否正在进行背景切换动画
+     */
+    [[nodiscard]] bool isTransitionRunning() const;
+
+    /**
+     * @brief 获取当前（或最近一次）切换动画的统计：绘制帧数、掉帧数和最长帧间隔
+     */
+    [[nodiscard]] TransitionStats getTransitionStats() const;
+
     /**
      * @brief 设置过渡透明度（用于动画，通常不需要手动调用）
      */
@@ -147,16 +648,293 @@ public:
      */
     [[nodiscard]] qreal getTransitionOpacity() const { return _transitionOpacity; }
 
+Q_SIGNALS:
+    /**
+     * @brief 背景图片加载完成（同步和异步模式均会发出）
+     * @param path 图片路径
+     */
+    void backgroundLoaded(const QString &path);
+
+    /**
+     * @brief 背景图片加载失败
+     * @param path 图片路径
+     * @param errorString 错误信息
+     */
+    void loadFailed(const QString &path, const QString &errorString);
+
+    /**
+     * @brief 背景切换动画完成（可通过 getTransitionStats 获取本次动画的统计）
+     */
+    void transitionFinished();
+
 protected:
+    bool event(QEvent *event) override;
+
     void paintEvent(QPaintEvent *event) override;
 
     void resizeEvent(QResizeEvent *event) override;
 
+    void mousePressEvent(QMouseEvent *event) override;
+
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+    void wheelEvent(QWheelEvent *event) override;
+
+    void showEvent(QShowEvent *event) override;
+
+    void hideEvent(QHideEvent *event) override;
+
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private:
+    /**
+     * @brief 处理解码结果（同步和异步加载共用）
+     * @param path 图片路径
+     * @param serial 发起加载时的请求序号，过期的结果会被丢弃
+     * @param image 解码结果
+     * @param sourceSize 原始图片尺寸
+     * @param errorString 错误信息
+     * @return 是否成功应用
+     */
+    bool onImageDecoded(const QString &path, quint64 serial, const QImage &image, const QSize &sourceSize, const QString &errorString);
+
+    /**
+     * @brief 渐进加载：还没有显示任何画面时先显示图片的预览
+     */
+    void showPreview(const QString &path);
+
+    /**
+     * @brief 移除显示中的预览（加载失败时）
+     */
+    void resetPreview();
+
+    /**
+     * @brief 渐进加载：图片还没有预览时在后台生成并保存
+     */
+    void storePreview(const QString &path, const QImage &image) const;
+
+    /**
+     * @brief 按当前控件尺寸、设备像素比和缩放设置创建准备请求
+     */
+    [[nodiscard]] PreparedBackground backgroundRequest(const QString &path) const;
+
+    /**
+     * @brief 延迟把当前缩放结果写入磁盘缓存（尺寸稳定后只写一次）
+     */
+    void scheduleDiskCacheStore();
+
+    /**
+     * @brief 在后台线程把当前缩放结果写入磁盘缓存
+     */
+    void storeOnDiskCache();
+
+    /**
+     * @brief 应用新的背景图片（启动过渡动画）
+     * @param prescaled 可选，预先缩放好的结果（尺寸不符时忽略）
+     */
+    void applyBackgroundImage(const QImage &image, const QImage &prescaled = QImage());
+
     /**
      * @brief 更新缩放后的图片
+     * @param prescaled 可选，预先缩放好的结果（尺寸与目标尺寸一致时直接使用）
+     */
+    void updateScaledPixmap(const QImage &prescaled = QImage());
+
+    /**
+     * @brief 在后台线程构建当前图片的金字塔（已在构建时忽略）
+     */
+    void requestMipPyramid();
+
+    /**
+     * @brief 计算按显示尺寸解码时的目标尺寸（物理像素，向上取整以减少重新解码）
+     * @return 目标尺寸，未启用内存精简模式或控件不可见时为空
+     */
+    [[nodiscard]] QSize decodeBoundingSize() const;
+
+    /**
+     * @brief 确保已解码的分辨率满足当前控件尺寸（不足时重新解码，过大时缩小）
+     *
+     * 来自磁盘缓存的图片只有写入时的显示分辨率，不足时同样重新解码
+     */
+    void ensureDecodedResolution();
+
+    /**
+     * @brief 计算当前图片在进程级缓存中的缩放结果键（未启用缓存或没有来源键时为空）
+     */
+    [[nodiscard]] QString scaledCacheKey(qreal devicePixelRatio) const;
+
+    /**
+     * @brief 计算当前图片按缩放模式缩放后的尺寸（物理像素）
+     */
+    [[nodiscard]] QSize scaledTargetSize() const;
+
+    /**
+     * @brief 计算图片在当前控件尺寸下的目标绘制区域（按缩放模式居中）
+     * @param imageSize 图片尺寸
+     */
+    [[nodiscard]] QRect calculateTargetRect(const QSize &imageSize) const;
+
+    /**
+     * @brief 标记合成缓存失效（下次绘制前重新合成）
+     */
+    void invalidateComposite();
+
+    /**
+     * @brief 重新合成图层缓存（只有一个普通图片层时不需要缓存）
+     */
+    void rebuildComposite();
+
+    /**
+     * @brief 把当前图层合成为一张与控件等大的图片
+     * @param opaque 是否生成不透明图片（底层完全覆盖控件时）
+     */
+    [[nodiscard]] QPixmap renderLayers(bool opaque) const;
+
+    /**
+     * @brief 获取当前画面（用作过渡动画的旧画面）
+     */
+    [[nodiscard]] QPixmap currentFrame() const;
+
+    /**
+     * @brief 逐层绘制图层与暴露矩形相交的部分
+     * @param exposed 需要重绘的矩形（控件坐标）
+     * @param opacity 整体透明度（过渡动画）
+     */
+    void paintLayers(QPainter &painter, const QRect &exposed, qreal opacity) const;
+
+    /**
+     * @brief 绘制与控件等大的画面中与暴露矩形相交的部分（尺寸不同时拉伸）
+     */
+    void drawFrame(QPainter &painter, const QPixmap &frame, const QRect &exposed) const;
+
+    /**
+     * @brief 计算缩放后的图片在控件中的绘制区域（调整大小期间为拉伸后的区域，否则居中原尺寸）
+     */
+    [[nodiscard]] QRect scaledPixmapRect(const QPixmap &pixmap) const;
+
+    /**
+     * @brief 绘制一个暴露矩形内的图层（含过渡动画）
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void paintExposedRect(QPainter &painter, const QRect &exposed) const;
+
+    /**
+     * @brief 绘制缩放后的图片与暴露矩形相交的部分（只从源图中取对应区域）
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void drawScaledPixmap(QPainter &painter, const QPixmap &pixmap, const QRect &exposed) const;
+
+    /**
+     * @brief 把画面拉伸到目标区域，只绘制与暴露矩形相交的部分
+     * @param target 画面拉伸后的区域（控件坐标）
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void drawStretchedPixmap(QPainter &painter, const QPixmap &pixmap, const QRect &target, const QRect &exposed) const;
+
+    /**
+     * @brief 绘制模糊结果（重新模糊期间把上一次的结果拉伸到当前缩放结果的位置）
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void drawBlurredPixmap(QPainter &painter, const QRect &exposed) const;
+
+    /**
+     * @brief 按当前进度绘制平移缩放画面与暴露矩形相交的部分
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void drawKenBurns(QPainter &painter, const QRect &exposed) const;
+
+    /**
+     * @brief 绘制与暴露矩形相交的分块（未就绪的分块用概览图代替）
+     * @param exposed 需要重绘的矩形（控件坐标）
+     */
+    void drawTiles(QPainter &painter, const QRect &exposed) const;
+
+    /**
+     * @brief 分块模式下的显示缩放比例（控件像素 / 原图像素）
+     */
+    [[nodiscard]] qreal tiledScale() const;
+
+    /**
+     * @brief 限制视图中心，使图片大于控件时不露出边缘
+     */
+    void clampViewCenter();
+
+    /**
+     * @brief 退出分块模式并释放分块缓存
+     */
+    void resetTiledImage();
+
+    /**
+     * @brief 显示动态背景的新一帧
+     */
+    void onAnimationFrame(const QPixmap &frame);
+
+    /**
+     * @brief 停止动态背景并释放帧缓存
+     */
+    void resetAnimation();
+
+    /**
+     * @brief 所在屏幕或设备像素比变化：在后台按新的物理像素重新缩放，完成前继续绘制旧的缩放结果
+     */
+    void onDevicePixelRatioChanged();
+
+    /**
+     * @brief 在后台模糊当前的缩放结果（已有对应的模糊结果时不重复计算）
+     */
+    void requestBlur();
+
+    /**
+     * @brief 丢弃模糊结果和尚未完成的模糊请求
+     */
+    void resetBlur();
+
+    /**
+     * @brief 在后台准备平移缩放用的放大缩放结果（参数未变化时不重复准备）
+     */
+    void requestKenBurnsPixmap();
+
+    /**
+     * @brief 释放平移缩放的缩放结果
+     */
+    void resetKenBurnsPixmap();
+
+    /**
+     * @brief 根据可见性启动、暂停或恢复平移缩放动画
+     */
+    void updateKenBurnsState();
+
+    /**
+     * @brief 平移缩放的缩放结果是否可以绘制（属于当前图片）
+     */
+    [[nodiscard]] bool isKenBurnsReady() const;
+
+    /**
+     * @brief 当前进度下控件对应的源矩形（平移缩放的缩放结果中的像素坐标）
+     */
+    [[nodiscard]] QRectF kenBurnsSourceRect() const;
+
+    /**
+     * @brief 根据可见性安排释放或恢复缓冲区
+     */
+    void updateTrimState();
+
+    /**
+     * @brief 按策略释放像素缓冲区（保留占位缩略图）
+     */
+    void trimBuffers(BackgroundTrimPolicy policy);
+
+    /**
+     * @brief 在后台重新生成被释放的缓冲区
+     */
+    void restoreBuffers();
+
+    /**
+     * @brief 放弃释放状态（设置新图片或清除背景时）
      */
-    void updateScaledPixmap();
+    void discardTrimState();
 
     /**
      * @brief 绘制默认背景（渐变或纯色）
@@ -164,24 +942,103 @@ private:
     void drawDefaultBackground(QPainter &painter) const;
 
     // 背景图片
-    QPixmap _backgroundImage;     // 原始图片
+    QImage  _backgroundImage;     // 原始图片（解码结果）
     QPixmap _scaledBackground;    // 缩放后的图片
-    QPixmap _oldScaledBackground; // 旧地缩放图片（用于动画）
+    QPixmap _oldFrame;            // 切换前的画面（用于动画）
+    QString _sourcePath;          // 图片来源路径（用于重新解码）
+    QString _sourceKey;           // 图片缓存键（ImageCache）
+    QSize   _sourceSize;          // 图片原始尺寸
 
     // 缩放设置
     BackgroundScaleMode _scaleMode;
-    bool                _smoothTransformation;
+    ScaleQuality        _scaleQuality;
+
+    // 图片金字塔
+    std::shared_ptr<const MipPyramid> _mipPyramid;      // 当前图片的金字塔（未构建时为空）
+    bool                              _mipmapsEnabled;  // 是否使用图片金字塔
+    bool                              _mipBuildPending; // 是否正在后台构建
+
+    // 交互式调整大小
+    QTimer *_resizeIdleTimer;   // 调整大小空闲定时器
+    bool    _interactiveResize; // 是否启用交互式调整大小
+    int     _deferredRescales;  // 本轮调整大小中被推迟的缩放次数
+    int     _coalescedRescales; // 累计被合并的缩放次数
+
+    // 加载设置
+    BackgroundLoadMode _loadMode;           // 加载模式
+    quint64            _loadSerial;         // 加载请求序号（用于丢弃过期的异步结果）
+    int                _pendingLoads;       // 正在进行的异步加载数量
+    bool               _downsampleOnDecode; // 是否按显示尺寸解码
+    bool               _redecodePending;    // 是否正在重新解码
+    bool               _displayResolution;  // 图片是否为磁盘缓存中的缩放结果（只有写入时的显示分辨率）
+    QTimer            *_diskCacheTimer;     // 磁盘缓存写入延迟定时器（首次使用时创建）
+    bool               _progressiveLoading; // 是否渐进加载（加载期间先显示预览）
+
+    // 图层
+    QList<BackgroundLayer> _layers;         // 自定义图层（为空时使用默认图层）
+    QPixmap                _composite;      // 图层合成缓存（与控件等大）
+    bool                   _compositeDirty; // 合成缓存是否需要重新生成
+
+    // 分块图片
+    TiledImage *_tiledImage;      // 分块图片（非分块模式时为空）
+    qint64      _tileMemoryLimit; // 分块缓存内存上限
+    qreal       _zoom;            // 缩放倍数
+    QPointF     _viewCenter;      // 控件中心对应的原图坐标
+    bool        _panZoomEnabled;  // 是否允许鼠标平移和缩放
+    bool        _panning;         // 是否正在拖动
+    QPoint      _panLastPos;      // 上一次拖动位置
+
+    // 动态背景
+    AnimatedBackground *_animation;           // 动态背景（非动态背景时为空）
+    qint64              _animationCacheLimit; // 帧缓存内存上限
+    bool                _animationStarted;    // 是否已显示第一帧
+
+    // 内存释放
+    BackgroundTrimPolicy _trimPolicy;  // 释放策略
+    QTimer              *_trimTimer;   // 释放延迟定时器
+    QPointer<QWidget>    _trimWindow;  // 已安装事件过滤器的顶层窗口（最小化通知）
+    QPixmap              _placeholder; // 释放后绘制的占位缩略图（渐进加载时为预览）
+    bool                 _trimmed;     // 缓冲区是否已释放
+    quint64              _trimSerial;  // 释放/恢复请求序号（丢弃过期的恢复结果）
+
+    // 设备像素比
+    QPointer<QWindow> _screenWindow; // 已关联 screenChanged 信号的窗口
+    qreal             _rescaleDpr;   // 正在后台重新缩放的目标设备像素比（无时为0）
+
+    // 毛玻璃
+    QPixmap _blurredBackground; // 模糊后的缩放结果
+    qint64  _blurSourceKey;     // 模糊结果对应的缩放结果（QPixmap::cacheKey）
+    qint64  _blurImageKey;      // 模糊结果对应的原图（QImage::cacheKey）
+    int     _blurRadius;        // 模糊半径（逻辑像素，0 表示不模糊）
+    quint64 _blurSerial;        // 模糊请求序号（丢弃过期的结果）
+
+    // 平移缩放（Ken Burns）
+    QPropertyAnimation *_kenBurnsAnimation; // 循环推进 kenBurnsProgress 的内置动画
+    QPixmap             _kenBurnsPixmap;    // 放大 _kenBurnsZoom 倍的缩放结果
+    qint64              _kenBurnsImageKey;  // 该缩放结果对应的原图（QImage::cacheKey）
+    QString             _kenBurnsRequest;   // 最近一次准备请求的参数（图片、尺寸、模糊半径）
+    quint64             _kenBurnsSerial;    // 准备请求序号（丢弃过期的结果）
+    QPointF             _kenBurnsFrom;      // 完全缩小时的焦点
+    QPointF             _kenBurnsTo;        // 完全放大时的焦点
+    qreal               _kenBurnsZoom;      // 最大放大倍数
+    qreal               _kenBurnsProgress;  // 进度（0-1 为一个往返周期）
+    int                 _kenBurnsDuration;  // 往返周期时长（毫秒，0 表示不使用内置动画）
+    bool                _kenBurnsEnabled;   // 是否启用
+
+    // 运行时统计
+    std::shared_ptr<StatsBlock> _stats; // 本控件的统计（计入全局）
 
     // 颜色设置
     QColor _backgroundColor; // 背景色
     QColor _overlayColor;    // 遮罩颜色
 
     // 动画设置
-    QPropertyAnimation *_transitionAnimation; // 过渡动画
-    qreal               _transitionOpacity;   // 过渡透明度 (0.0-1.0)
-    int                 _transitionDuration;  // 动画时长（毫秒）
+    TransitionDriver *_transitionDriver;   // 过渡动画驱动器
+    qreal             _transitionOpacity;  // 过渡透明度 (0.0-1.0)
+    int               _transitionDuration; // 动画时长（毫秒）
 
     Q_PROPERTY(qreal transitionOpacity READ getTransitionOpacity WRITE setTransitionOpacity)
+    Q_PROPERTY(qreal kenBurnsProgress READ getKenBurnsProgress WRITE setKenBurnsProgress)
 };
 
 } // namespace Mel
@@ -5,6 +5,8 @@
 #include <QPainter>
 #include <QPalette>
 #include <QScreen>
+#include <QWindow>
+#include <utility>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -13,6 +15,9 @@
 
 namespace Mel {
 
+// 边框调整区域宽度（逻辑像素）
+constexpr int kResizeMargin = 4;
+
 // TitleBarButton 实现
 TitleBarButton::TitleBarButton(const QString &text, const QColor &hoverBg, QWidget *parent)
     : QPushButton(text, parent), _hoverBgColor(hoverBg) {
@@ -63,10 +68,18 @@ ElMainWindow::ElMainWindow(QWidget *parent)
     , _titleBarHeight(32)
     , _resizable(true)
     , _isHoverMaxButton(false)
+    , _hitTestDirty(true)
 #ifdef Q_OS_WIN
     , _currentWinID(0)
 #endif
+#ifdef Q_OS_LINUX
+    , _edgeCursor(false)
+#endif
 {
+#ifdef Q_OS_LINUX
+    // Windows 通过 WM_NCCALCSIZE 去掉边框；Linux 去掉窗口管理器的装饰，拖动和调整大小见 handleWindowMouseEvent
+    setWindowFlag(Qt::FramelessWindowHint);
+#endif
     setAttribute(Qt::WA_Mapped);
     setMouseTracking(true);
     setMinimumSize(400, 300);
@@ -109,6 +122,26 @@ void ElMainWindow::setupTitleBar() {
     layout->addWidget(_closeBtn);
     
     setMenuWidget(_titleBar);
+
+    // 标题栏和按钮的几何变化（布局、高度、显示隐藏）时重新构建命中测试表
+    for (QWidget *widget : {_titleBar, static_cast<QWidget *>(_minimizeBtn), static_cast<QWidget *>(_maximizeBtn), static_cast<QWidget *>(_closeBtn)}) {
+        widget->installEventFilter(this);
+    }
+}
+
+void ElMainWindow::addTitleBarClientWidget(QWidget *widget) {
+    if (!widget || _clientWidgets.contains(widget)) return;
+    _clientWidgets.append(widget);
+    widget->installEventFilter(this);
+    connect(widget, &QObject::destroyed, this, [this]() { _hitTestDirty = true; });
+    _hitTestDirty = true;
+}
+
+void ElMainWindow::removeTitleBarClientWidget(QWidget *widget) {
+    if (!widget || !_clientWidgets.removeAll(widget)) return;
+    widget->removeEventFilter(this);
+    disconnect(widget, &QObject::destroyed, this, nullptr);
+    _hitTestDirty = true;
 }
 
 void ElMainWindow::setTitleBarHeight(int height) {
@@ -163,8 +196,57 @@ bool ElMainWindow::containsCursorToItem(QWidget *item) const {
     return QRect(item->mapToGlobal(QPoint(0, 0)), item->size()).contains(QCursor::pos());
 }
 
+HitTestArea ElMainWindow::hitTestAt(const QPoint &pos) {
+    if (_hitTestDirty) {
+        rebuildHitTestMap();
+    }
+    return _hitTestMap.hitTest(pos, _resizable && !isFullScreen() && !isMaximized());
+}
+
+void ElMainWindow::rebuildHitTestMap() {
+    _hitTestDirty = false;
+
+    // 取控件的实际几何（窗口坐标），隐藏的控件为空矩形
+    const auto rectOf = [this](QWidget *widget) {
+        return widget && widget->isVisibleTo(this) ? QRect(widget->mapTo(this, QPoint(0, 0)), widget->size()) : QRect();
+    };
+
+    HitTestGeometry geometry;
+    geometry.windowSize     = size();
+    geometry.titleBar       = rectOf(_titleBar);
+    geometry.minimizeButton = rectOf(_minimizeBtn);
+    geometry.maximizeButton = rectOf(_maximizeBtn);
+    geometry.closeButton    = rectOf(_closeBtn);
+    geometry.resizeMargin   = kResizeMargin;
+    for (const QPointer<QWidget> &widget : std::as_const(_clientWidgets)) {
+        const QRect rect = rectOf(widget);
+        if (!rect.isEmpty()) {
+            geometry.clientRegions.append(rect);
+        }
+    }
+
+    if (geometry != _hitTestMap.getGeometry()) {
+        _hitTestMap.build(geometry);
+    }
+}
+
 bool ElMainWindow::eventFilter(QObject *obj, QEvent *event) {
+#ifdef Q_OS_LINUX
+    if (_windowHandle && obj == _windowHandle) {
+        return handleWindowMouseEvent(event) || QMainWindow::eventFilter(obj, event);
+    }
+#endif
+    if (obj != this) {
+        // 标题栏、按钮或注册的客户区控件的几何变化
+        const QEvent::Type type = event->type();
+        if (type == QEvent::Move || type == QEvent::Resize || type == QEvent::Show || type == QEvent::Hide || type == QEvent::ParentChange
+            || type == QEvent::LayoutRequest) {
+            _hitTestDirty = true;
+        }
+        return QMainWindow::eventFilter(obj, event);
+    }
     if (event->type() == QEvent::Resize && _titleBar) {
+        _hitTestDirty = true;
         _titleBar->resize(width(), _titleBarHeight);
     } else if (event->type() == QEvent::WindowStateChange) {
         updateMaximizeButton();
@@ -175,11 +257,103 @@ bool ElMainWindow::eventFilter(QObject *obj, QEvent *event) {
         DWORD style = ::GetWindowLongPtr(hwnd, GWL_STYLE);
         ::SetWindowLongPtr(hwnd, GWL_STYLE, (style & ~WS_SYSMENU) | WS_MAXIMIZEBOX | WS_THICKFRAME);
     }
+#endif
+#ifdef Q_OS_LINUX
+    else if (event->type() == QEvent::Show && windowHandle() != _windowHandle) {
+        // 在窗口上监听鼠标事件：边框区域与子控件重叠，子控件也不一定开启了鼠标跟踪
+        if (_windowHandle) {
+            _windowHandle->removeEventFilter(this);
+        }
+        _windowHandle = windowHandle();
+        if (_windowHandle) {
+            _windowHandle->installEventFilter(this);
+        }
+    }
 #endif
     return QMainWindow::eventFilter(obj, event);
 }
 
+#ifdef Q_OS_LINUX
+bool ElMainWindow::handleWindowMouseEvent(QEvent *event) {
+    if (event->type() == QEvent::Leave) {
+        updateEdgeCursor({});
+        return false;
+    }
+    if (event->type() != QEvent::MouseMove && event->type() != QEvent::MouseButtonPress && event->type() != QEvent::MouseButtonDblClick) {
+        return false;
+    }
+
+    // 顶层窗口的坐标即本控件坐标，与 Windows 使用同一张命中测试表
+    const auto       *mouseEvent = static_cast<QMouseEvent *>(event);
+    const HitTestArea area       = hitTestAt(mouseEvent->pos());
+    const bool        inTitleBar = area == HitTest_Caption;
+    const Qt::Edges   edges      = HitTestMap::toEdges(area);
+
+    switch (event->type()) {
+    case QEvent::MouseMove:
+        if (mouseEvent->buttons() == Qt::NoButton) {
+            updateEdgeCursor(edges);
+        }
+        return false;
+
+    case QEvent::MouseButtonPress:
+        if (mouseEvent->button() != Qt::LeftButton) {
+            return false;
+        }
+        // 交给窗口管理器拖动或调整大小（不支持时返回 false，事件照常分发）
+        if (edges) {
+            return _windowHandle->startSystemResize(edges);
+        }
+        if (inTitleBar) {
+            return _windowHandle->startSystemMove();
+        }
+        return false;
+
+    case QEvent::MouseButtonDblClick:
+        // 双击标题栏最大化/还原，不可调整大小时忽略
+        if (mouseEvent->button() == Qt::LeftButton && inTitleBar) {
+            if (_resizable) {
+                onMaximizeClicked();
+            }
+            return true;
+        }
+        return false;
+
+    default:
+        return false;
+    }
+}
+
+void ElMainWindow::updateEdgeCursor(Qt::Edges edges) {
+    if (!edges) {
+        if (_edgeCursor) {
+            _edgeCursor = false;
+            unsetCursor();
+        }
+        return;
+    }
+
+    Qt::CursorShape shape = Qt::SizeVerCursor;
+    if (edges == (Qt::LeftEdge | Qt::TopEdge) || edges == (Qt::RightEdge | Qt::BottomEdge)) {
+        shape = Qt::SizeFDiagCursor;
+    } else if (edges == (Qt::RightEdge | Qt::TopEdge) || edges == (Qt::LeftEdge | Qt::BottomEdge)) {
+        shape = Qt::SizeBDiagCursor;
+    } else if (edges & (Qt::LeftEdge | Qt::RightEdge)) {
+        shape = Qt::SizeHorCursor;
+    }
+    _edgeCursor = true;
+    setCursor(shape);
+}
+#endif
+
 #ifdef Q_OS_WIN
+// 非客户区消息中的屏幕坐标（物理像素）转换为窗口坐标（逻辑像素）
+static QPoint clientPos(const MSG *msg, qreal dpr) {
+    POINT pt{GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam)};
+    ::ScreenToClient(msg->hwnd, &pt);
+    return {static_cast<int>(pt.x / dpr), static_cast<int>(pt.y / dpr)};
+}
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 bool ElMainWindow::nativeEvent(const QByteArray &eventType, void *message, qintptr *result)
 #else
@@ -226,32 +400,10 @@ bool ElMainWindow::nativeEvent(const QByteArray &eventType, void *message, long
     }
     
     case WM_NCHITTEST: {
-        POINT pt{GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam)};
-        ::ScreenToClient(msg->hwnd, &pt);
-        
-        RECT rc;
-        ::GetClientRect(msg->hwnd, &rc);
-        
-        // 使用设备像素比转换坐标
-        qreal dpr = devicePixelRatioF();
-        int ptX = static_cast<int>(pt.x / dpr);
-        int ptY = static_cast<int>(pt.y / dpr);
-        int clientWidth = static_cast<int>(rc.right / dpr);
-        int titleBarH = _titleBarHeight;
-        int btnWidth = 46;
-        
-        // 计算按钮区域（从右到左：关闭、最大化、最小化）
-        int closeBtnLeft = clientWidth - btnWidth;
-        int maxBtnLeft = clientWidth - btnWidth * 2;
-        int minBtnLeft = clientWidth - btnWidth * 3;
-        
-        bool inTitleBar = ptY < titleBarH;
-        bool inCloseBtn = inTitleBar && ptX >= closeBtnLeft;
-        bool inMaxBtn = inTitleBar && ptX >= maxBtnLeft && ptX < closeBtnLeft;
-        bool inMinBtn = inTitleBar && ptX >= minBtnLeft && ptX < maxBtnLeft;
+        const HitTestArea area = hitTestAt(clientPos(msg, devicePixelRatioF()));
         
         // 最大化按钮 - Snap Layout 支持
-        if (inMaxBtn && _maximizeBtn->isVisible()) {
+        if (area == HitTest_Maximize) {
             if (!_isHoverMaxButton) {
                 _isHoverMaxButton = true;
                 _maximizeBtn->setHovered(true);
@@ -264,35 +416,19 @@ bool ElMainWindow::nativeEvent(const QByteArray &eventType, void *message, long
             _maximizeBtn->setHovered(false);
         }
         
-        // 其他按钮返回 HTCLIENT 让 Qt 处理点击
-        if (inCloseBtn || inMinBtn) {
-            *result = HTCLIENT;
-            return true;
+        // 其他按钮和注册的客户区返回 HTCLIENT 让 Qt 处理点击
+        switch (area) {
+        case HitTest_Left:        *result = HTLEFT; break;
+        case HitTest_Right:       *result = HTRIGHT; break;
+        case HitTest_Top:         *result = HTTOP; break;
+        case HitTest_Bottom:      *result = HTBOTTOM; break;
+        case HitTest_TopLeft:     *result = HTTOPLEFT; break;
+        case HitTest_TopRight:    *result = HTTOPRIGHT; break;
+        case HitTest_BottomLeft:  *result = HTBOTTOMLEFT; break;
+        case HitTest_BottomRight: *result = HTBOTTOMRIGHT; break;
+        case HitTest_Caption:     *result = HTCAPTION; break;
+        default:                  *result = HTCLIENT; break;
         }
-        
-        const int m = static_cast<int>(4 * dpr);
-        bool l = pt.x < m, r = pt.x > rc.right - m;
-        bool t = pt.y < m, b = pt.y > rc.bottom - m;
-        
-        // 边框调整
-        if (_resizable && !isFullScreen() && !isMaximized()) {
-            if (l && b) { *result = HTBOTTOMLEFT; return true; }
-            if (r && b) { *result = HTBOTTOMRIGHT; return true; }
-            if (l && t && !inTitleBar) { *result = HTTOPLEFT; return true; }
-            if (r && t && !inTitleBar) { *result = HTTOPRIGHT; return true; }
-            if (l) { *result = HTLEFT; return true; }
-            if (r) { *result = HTRIGHT; return true; }
-            if (t && !inTitleBar) { *result = HTTOP; return true; }
-            if (b) { *result = HTBOTTOM; return true; }
-        }
-        
-        // 标题栏拖动
-        if (inTitleBar) {
-            *result = HTCAPTION;
-            return true;
-        }
-        
-        *result = HTCLIENT;
         return true;
     }
     
@@ -327,42 +463,16 @@ bool ElMainWindow::nativeEvent(const QByteArray &eventType, void *message, long
         return false;
     }
     
-    case WM_NCLBUTTONDOWN: {
-        POINT pt{GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam)};
-        ::ScreenToClient(msg->hwnd, &pt);
-        RECT rc;
-        ::GetClientRect(msg->hwnd, &rc);
-        qreal dpr = devicePixelRatioF();
-        int ptX = static_cast<int>(pt.x / dpr);
-        int ptY = static_cast<int>(pt.y / dpr);
-        int clientWidth = static_cast<int>(rc.right / dpr);
-        int btnWidth = 46;
-        bool inMaxBtn = ptY < _titleBarHeight && 
-                        ptX >= clientWidth - btnWidth * 2 && 
-                        ptX < clientWidth - btnWidth;
-        if (inMaxBtn) return true;
+    case WM_NCLBUTTONDOWN:
+        if (hitTestAt(clientPos(msg, devicePixelRatioF())) == HitTest_Maximize) return true;
         break;
-    }
         
-    case WM_NCLBUTTONUP: {
-        POINT pt{GET_X_LPARAM(msg->lParam), GET_Y_LPARAM(msg->lParam)};
-        ::ScreenToClient(msg->hwnd, &pt);
-        RECT rc;
-        ::GetClientRect(msg->hwnd, &rc);
-        qreal dpr = devicePixelRatioF();
-        int ptX = static_cast<int>(pt.x / dpr);
-        int ptY = static_cast<int>(pt.y / dpr);
-        int clientWidth = static_cast<int>(rc.right / dpr);
-        int btnWidth = 46;
-        bool inMaxBtn = ptY < _titleBarHeight && 
-                        ptX >= clientWidth - btnWidth * 2 && 
-                        ptX < clientWidth - btnWidth;
-        if (inMaxBtn) { 
+    case WM_NCLBUTTONUP:
+        if (hitTestAt(clientPos(msg, devicePixelRatioF())) == HitTest_Maximize) {
             onMaximizeClicked(); 
             return true; 
         }
         break;
-    }
         
     case WM_NCLBUTTONDBLCLK:
         if (!_resizable) return true;
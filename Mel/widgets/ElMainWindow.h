@@ -2,10 +2,14 @@
 #define MEL_ELMAINWINDOW_H
 
 #include <QMainWindow>
+#include <QPointer>
 #include <QPushButton>
 #include "Mel_export.h"
+#include "HitTestMap.h"
 
 class QHBoxLayout;
+class QMouseEvent;
+class QWindow;
 
 namespace Mel {
 
@@ -27,6 +31,9 @@ private:
 
 /**
  * @brief 无边框主窗口（支持 Windows 原生动画和 Snap Layout）
+ *
+ * Linux（X11/Wayland）上通过 QWindow::startSystemMove/startSystemResize 把标题栏拖动和边框调整交给窗口管理器，
+ * 与原生窗口一样流畅，不需要在每次鼠标移动时 move()
  */
 class MEL_EXPORT ElMainWindow : public QMainWindow {
     Q_OBJECT
@@ -41,6 +48,13 @@ public:
     void setResizable(bool resizable);
     [[nodiscard]] bool isResizable() const { return _resizable; }
 
+    // 标题栏（可以向其布局中添加自定义控件）
+    [[nodiscard]] QWidget *titleBar() const { return _titleBar; }
+
+    // 将标题栏中的控件注册为客户区：点击交给控件处理，不拖动窗口
+    void addTitleBarClientWidget(QWidget *widget);
+    void removeTitleBarClientWidget(QWidget *widget);
+
 Q_SIGNALS:
     void closeButtonClicked();
 
@@ -65,6 +79,17 @@ private:
     void updateMaximizeButton();
     bool containsCursorToItem(QWidget *item) const;
 
+    // 查询位置（逻辑像素，窗口坐标）所在的区域，几何变化后的第一次查询时重新构建命中测试表
+    HitTestArea hitTestAt(const QPoint &pos);
+    void rebuildHitTestMap();
+
+#ifdef Q_OS_LINUX
+    // 处理窗口收到的鼠标事件（在分发给子控件之前），返回是否已处理
+    bool handleWindowMouseEvent(QEvent *event);
+    // 按调整边缘更新光标形状
+    void updateEdgeCursor(Qt::Edges edges);
+#endif
+
     QWidget        *_titleBar;
     TitleBarButton *_minimizeBtn;
     TitleBarButton *_maximizeBtn;
@@ -73,10 +98,19 @@ private:
     int  _titleBarHeight;
     bool _resizable;
     bool _isHoverMaxButton;
+
+    HitTestMap               _hitTestMap;    // 命中测试表
+    QList<QPointer<QWidget>> _clientWidgets; // 标题栏中注册为客户区的控件
+    bool                     _hitTestDirty;  // 几何变化后需要重新构建
     
 #ifdef Q_OS_WIN
     qint64 _currentWinID;
 #endif
+
+#ifdef Q_OS_LINUX
+    QPointer<QWindow> _windowHandle; // 已安装事件过滤器的窗口
+    bool              _edgeCursor;   // 是否正在显示调整大小的光标
+#endif
 };
 
 } // namespace Mel
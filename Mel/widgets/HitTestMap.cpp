@@ -0,0 +1,122 @@
+/**
+ * @file HitTestMap.cpp
+ * @brief 命中测试表实现
+ */
+
+#include "HitTestMap.h"
+#include <QPair>
+#include <algorithm>
+
+namespace Mel {
+
+bool HitTestGeometry::operator==(const HitTestGeometry &other) const {
+    return windowSize == other.windowSize && titleBar == other.titleBar && minimizeButton == other.minimizeButton && maximizeButton == other.maximizeButton
+        && closeButton == other.closeButton && clientRegions == other.clientRegions && resizeMargin == other.resizeMargin;
+}
+
+void HitTestMap::build(const HitTestGeometry &geometry) {
+    _geometry = geometry;
+    _titleBar = geometry.titleBar & QRect(QPoint(0, 0), geometry.windowSize);
+    _rowBands.clear();
+    _bands.clear();
+    if (_titleBar.isEmpty()) {
+        return;
+    }
+
+    // 按优先级从低到高排列，后写入的覆盖先写入的
+    QVector<QPair<QRect, HitTestArea>> regions;
+    for (const QRect &rect : geometry.clientRegions) {
+        regions.append({rect & _titleBar, HitTest_Client});
+    }
+    regions.append({geometry.minimizeButton & _titleBar, HitTest_Minimize});
+    regions.append({geometry.maximizeButton & _titleBar, HitTest_Maximize});
+    regions.append({geometry.closeButton & _titleBar, HitTest_Close});
+
+    // 条带边界：标题栏和各区域的上下边界
+    QVector<int> bounds{_titleBar.top(), _titleBar.bottom() + 1};
+    for (const auto &region : regions) {
+        if (!region.first.isEmpty()) {
+            bounds.append(region.first.top());
+            bounds.append(region.first.bottom() + 1);
+        }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+    _rowBands.resize(_titleBar.height());
+    for (int i = 0; i + 1 < bounds.size(); ++i) {
+        const int top    = bounds[i];
+        const int bottom = bounds[i + 1]; // 不含
+
+        // 条带内每一行相同，按第一行填充
+        QVector<quint8> columns(_titleBar.width(), HitTest_Caption);
+        for (const auto &region : regions) {
+            const QRect &rect = region.first;
+            if (rect.isEmpty() || top < rect.top() || top > rect.bottom()) {
+                continue;
+            }
+            std::fill(columns.begin() + (rect.left() - _titleBar.left()), columns.begin() + (rect.right() + 1 - _titleBar.left()), static_cast<quint8>(region.second));
+        }
+
+        const int band = _bands.size();
+        _bands.append(columns);
+        std::fill(_rowBands.begin() + (top - _titleBar.top()), _rowBands.begin() + (bottom - _titleBar.top()), band);
+    }
+}
+
+HitTestArea HitTestMap::hitTest(const QPoint &pos, const bool resizable) const {
+    const bool inTitleBar = _titleBar.contains(pos);
+
+    // 标题栏按钮和客户区优先于边框
+    if (inTitleBar) {
+        const auto area = static_cast<HitTestArea>(_bands[_rowBands[pos.y() - _titleBar.top()]][pos.x() - _titleBar.left()]);
+        if (area != HitTest_Caption) {
+            return area;
+        }
+    }
+
+    if (resizable) {
+        const QSize &size   = _geometry.windowSize;
+        const int    margin = _geometry.resizeMargin;
+        const bool   left   = pos.x() < margin;
+        const bool   right  = pos.x() >= size.width() - margin;
+        const bool   top    = pos.y() < margin && (!inTitleBar || left || right); // 标题栏内的上边缘用于拖动，两个上角仍可调整
+        const bool   bottom = pos.y() >= size.height() - margin;
+
+        if (left && bottom) return HitTest_BottomLeft;
+        if (right && bottom) return HitTest_BottomRight;
+        if (left && top) return HitTest_TopLeft;
+        if (right && top) return HitTest_TopRight;
+        if (left) return HitTest_Left;
+        if (right) return HitTest_Right;
+        if (top) return HitTest_Top;
+        if (bottom) return HitTest_Bottom;
+    }
+
+    return inTitleBar ? HitTest_Caption : HitTest_Client;
+}
+
+Qt::Edges HitTestMap::toEdges(const HitTestArea area) {
+    switch (area) {
+        case HitTest_Left:
+            return Qt::LeftEdge;
+        case HitTest_Right:
+            return Qt::RightEdge;
+        case HitTest_Top:
+            return Qt::TopEdge;
+        case HitTest_Bottom:
+            return Qt::BottomEdge;
+        case HitTest_TopLeft:
+            return Qt::TopEdge | Qt::LeftEdge;
+        case HitTest_TopRight:
+            return Qt::TopEdge | Qt::RightEdge;
+        case HitTest_BottomLeft:
+            return Qt::BottomEdge | Qt::LeftEdge;
+        case HitTest_BottomRight:
+            return Qt::BottomEdge | Qt::RightEdge;
+        default:
+            return {};
+    }
+}
+
+} // namespace Mel
@@ -0,0 +1,96 @@
+/**
+ * @file HitTestMap.h
+ * @brief 无边框窗口的命中测试表 - 几何变化时构建一次，之后每次鼠标移动 O(1) 查询，与平台无关
+ */
+
+#ifndef MEL_HITTESTMAP_H
+#define MEL_HITTESTMAP_H
+
+#include "Mel_export.h"
+#include <QRect>
+#include <QVector>
+
+namespace Mel {
+
+/**
+ * @brief 命中区域
+ */
+enum HitTestArea : quint8 {
+    HitTest_Client      = 0,  // 客户区（交给控件处理）
+    HitTest_Caption     = 1,  // 标题栏空白处（拖动窗口）
+    HitTest_Minimize    = 2,  // 最小化按钮
+    HitTest_Maximize    = 3,  // 最大化按钮（Windows 上用于 Snap Layout）
+    HitTest_Close       = 4,  // 关闭按钮
+    HitTest_Left        = 5,  // 左边框
+    HitTest_Right       = 6,  // 右边框
+    HitTest_Top         = 7,  // 上边框
+    HitTest_Bottom      = 8,  // 下边框
+    HitTest_TopLeft     = 9,  // 左上角
+    HitTest_TopRight    = 10, // 右上角
+    HitTest_BottomLeft  = 11, // 左下角
+    HitTest_BottomRight = 12  // 右下角
+};
+
+/**
+ * @brief 命中测试表的输入几何（逻辑像素，窗口坐标）
+ *
+ * 按钮和客户区取自控件的实际几何，隐藏的控件传入空矩形
+ */
+struct MEL_EXPORT HitTestGeometry {
+    QSize          windowSize;       // 窗口尺寸
+    QRect          titleBar;         // 标题栏
+    QRect          minimizeButton;   // 最小化按钮
+    QRect          maximizeButton;   // 最大化按钮
+    QRect          closeButton;      // 关闭按钮
+    QVector<QRect> clientRegions;    // 标题栏中注册为客户区的控件（如搜索框、菜单按钮）
+    int            resizeMargin = 4; // 边框调整区域宽度
+
+    bool operator==(const HitTestGeometry &other) const;
+
+    bool operator!=(const HitTestGeometry &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 命中测试表
+ *
+ * 优先级与 Windows 的 WM_NCHITTEST 处理一致：标题栏按钮和客户区 > 边框 > 标题栏 > 客户区，
+ * 标题栏内的上边缘用于拖动而不是调整大小（两个上角仍然沿对角线调整）。
+ *
+ * 标题栏按按钮和客户区的上下边界分成若干水平条带，每个条带保存一行按列索引的区域表，
+ * 另有一张按行索引条带的表；查询只需两次查表，边框由坐标直接计算。
+ * 表只依赖逻辑坐标，设备像素比只影响调用方的坐标换算
+ */
+class MEL_EXPORT HitTestMap {
+public:
+    /**
+     * @brief 按几何构建命中测试表（耗时与条带数 × 标题栏宽度成正比）
+     */
+    void build(const HitTestGeometry &geometry);
+
+    /**
+     * @brief 获取构建时的几何
+     */
+    [[nodiscard]] const HitTestGeometry &getGeometry() const { return _geometry; }
+
+    /**
+     * @brief 查询位置所在的区域
+     * @param pos 位置（逻辑像素，窗口坐标）
+     * @param resizable 是否可调整大小（已最大化或全屏时应为 false）
+     */
+    [[nodiscard]] HitTestArea hitTest(const QPoint &pos, bool resizable) const;
+
+    /**
+     * @brief 边框区域对应的调整边缘（其他区域为空）
+     */
+    [[nodiscard]] static Qt::Edges toEdges(HitTestArea area);
+
+private:
+    HitTestGeometry          _geometry;  // 构建时的几何
+    QRect                    _titleBar;  // 裁剪到窗口内的标题栏
+    QVector<int>             _rowBands;  // 标题栏每一行所属的条带
+    QVector<QVector<quint8>> _bands;     // 每个条带按列的区域（HitTestArea）
+};
+
+} // namespace Mel
+
+#endif // MEL_HITTESTMAP_H
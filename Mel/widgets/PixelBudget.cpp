@@ -0,0 +1,133 @@
+/**
+ * @file PixelBudget.cpp
+ * @brief 全局像素内存预算实现
+ */
+
+#include "PixelBudget.h"
+#include "BackgroundWidget.h"
+#include "core/Logging.h"
+#include <QCoreApplication>
+#include <QTimer>
+
+namespace Mel {
+
+namespace {
+
+/**
+ * @brief 预算检查的合并间隔（毫秒）：动画期间每帧都会绘制，检查最多每个间隔一次
+ */
+constexpr int kCheckInterval = 250;
+
+} // namespace
+
+PixelBudget &PixelBudget::instance() {
+    static PixelBudget budget;
+    return budget;
+}
+
+PixelBudget::PixelBudget() :
+    _budget(0), _checkTimer(nullptr), _exceeded(false), _evictions(0), _releasedBytes(0) {
+    // 预算检查通过定时器合并，始终在主线程进行
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        moveToThread(app->thread());
+    }
+
+    _checkTimer = new QTimer(this);
+    _checkTimer->setSingleShot(true);
+    _checkTimer->setInterval(kCheckInterval);
+    connect(_checkTimer, &QTimer::timeout, this, &PixelBudget::enforce);
+}
+
+PixelBudget::~PixelBudget() = default;
+
+// ========== 预算 ==========
+
+void PixelBudget::setBudget(const qint64 bytes) {
+    _budget = qMax<qint64>(0, bytes);
+    requestCheck();
+}
+
+qint64 PixelBudget::getUsage() const {
+    qint64 bytes = 0;
+    for (const BackgroundWidget *widget : _widgets) {
+        bytes += widget->getPixelMemoryBytes();
+    }
+    return bytes;
+}
+
+PixelBudgetStats PixelBudget::getStats() const {
+    PixelBudgetStats stats;
+    stats.bytes         = getUsage();
+    stats.budget        = _budget;
+    stats.widgetCount   = _widgets.size();
+    stats.evictions     = _evictions;
+    stats.releasedBytes = _releasedBytes;
+    return stats;
+}
+
+// ========== 控件登记 ==========
+
+void PixelBudget::registerWidget(BackgroundWidget *widget) {
+    if (!_widgets.contains(widget)) {
+        _widgets.append(widget);
+    }
+}
+
+void PixelBudget::unregisterWidget(BackgroundWidget *widget) {
+    _widgets.removeOne(widget);
+}
+
+void PixelBudget::touch(BackgroundWidget *widget) {
+    // 连续绘制同一个控件时已经在末尾，不需要移动
+    if (_widgets.isEmpty() || _widgets.last() != widget) {
+        _widgets.removeOne(widget);
+        _widgets.append(widget);
+    }
+    requestCheck();
+}
+
+void PixelBudget::requestCheck() {
+    // 已安排的检查不重新计时，持续绘制时也能按间隔检查
+    if (_budget <= 0 || _checkTimer->isActive()) {
+        return;
+    }
+    _checkTimer->start();
+}
+
+void PixelBudget::enforce() {
+    if (_budget <= 0) {
+        _exceeded = false;
+        return;
+    }
+
+    qint64 bytes = getUsage();
+    if (bytes <= _budget) {
+        _exceeded = false;
+        return;
+    }
+
+    // 释放过程中控件不会被销毁，但可能登记新的绘制，按快照的顺序进行
+    const QList<BackgroundWidget *> order = _widgets;
+    for (BackgroundWidget *widget : order) {
+        const qint64 released = widget->releaseDerivableBuffers();
+        if (released <= 0) {
+            continue;
+        }
+        ++_evictions;
+        _releasedBytes += released;
+        bytes -= released;
+        qCDebug(lcMel) << "PixelBudget: 超出预算，释放" << widget << released << "字节，剩余" << bytes << "/" << _budget;
+        if (bytes <= _budget) {
+            _exceeded = false;
+            return;
+        }
+    }
+
+    if (!_exceeded) {
+        _exceeded = true;
+        qCDebug(lcMel) << "PixelBudget: 释放后仍超出预算:" << bytes << "/" << _budget;
+        Q_EMIT budgetExceeded(bytes, _budget);
+    }
+}
+
+} // namespace Mel
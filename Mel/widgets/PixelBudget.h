@@ -0,0 +1,125 @@
+/**
+ * @file PixelBudget.h
+ * @brief 全局像素内存预算 - 统计所有 BackgroundWidget 持有的像素缓冲区并在超出时释放
+ */
+
+#ifndef MEL_PIXELBUDGET_H
+#define MEL_PIXELBUDGET_H
+
+#include "Mel_export.h"
+#include <QList>
+#include <QObject>
+
+class QTimer;
+
+namespace Mel {
+
+class BackgroundWidget;
+
+/**
+ * @brief 像素内存预算统计信息
+ */
+struct MEL_EXPORT PixelBudgetStats {
+    qint64  bytes         = 0; // 所有控件当前持有的字节数
+    qint64  budget        = 0; // 字节预算（0 表示不限制）
+    int     widgetCount   = 0; // 参与统计的控件数量
+    quint64 evictions     = 0; // 因超出预算而释放缓冲区的次数
+    qint64  releasedBytes = 0; // 累计释放的字节数
+};
+
+/**
+ * @brief 全局像素内存预算（单例，只在主线程使用）
+ *
+ * 每个 BackgroundWidget 创建时登记，每次绘制时标记为最近使用。
+ * 所有控件持有的字节数（BackgroundWidget::getPixelMemoryBytes 之和）超出预算时，
+ * 按最近最少绘制的顺序让控件释放可重新生成的缓冲区，直到回到预算以内：
+ * - 隐藏或最小化的控件释放缩放结果、合成缓存和图片金字塔（能从来源路径重新读取时连同原图），重新显示时在后台恢复
+ * - 可见的控件只释放图片金字塔和合成缓存，之后逐层绘制
+ *
+ * 通常通过 MelLib::setPixelMemoryBudget 设置
+ */
+class MEL_EXPORT PixelBudget : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 获取全局实例
+     */
+    static PixelBudget &instance();
+
+    PixelBudget(const PixelBudget &) = delete;
+
+    PixelBudget &operator=(const PixelBudget &) = delete;
+
+    // ========== 预算 ==========
+
+    /**
+     * @brief 设置字节预算（默认 0，不限制）
+     */
+    void setBudget(qint64 bytes);
+
+    /**
+     * @brief 获取字节预算
+     */
+    [[nodiscard]] qint64 getBudget() const { return _budget; }
+
+    /**
+     * @brief 获取所有控件当前持有的字节数
+     */
+    [[nodiscard]] qint64 getUsage() const;
+
+    /**
+     * @brief 获取统计信息
+     */
+    [[nodiscard]] PixelBudgetStats getStats() const;
+
+    // ========== 控件登记（由 BackgroundWidget 调用） ==========
+
+    /**
+     * @brief 登记控件（作为最近使用）
+     */
+    void registerWidget(BackgroundWidget *widget);
+
+    /**
+     * @brief 注销控件
+     */
+    void unregisterWidget(BackgroundWidget *widget);
+
+    /**
+     * @brief 控件刚刚绘制：移到最近使用的位置并安排一次预算检查
+     */
+    void touch(BackgroundWidget *widget);
+
+    /**
+     * @brief 控件持有的缓冲区增加了：安排一次预算检查（间隔内的多次请求合并为一次）
+     */
+    void requestCheck();
+
+Q_SIGNALS:
+    /**
+     * @brief 释放后仍超出预算（剩余的缓冲区都是绘制所必需的；持续超出时只发出一次）
+     * @param bytes 当前持有的字节数
+     * @param budget 字节预算
+     */
+    void budgetExceeded(qint64 bytes, qint64 budget);
+
+private:
+    PixelBudget();
+
+    ~PixelBudget() override;
+
+    /**
+     * @brief 超出预算时按最近最少绘制的顺序释放
+     */
+    void enforce();
+
+    QList<BackgroundWidget *> _widgets;       // 按最近绘制排序（最久未绘制的在前）
+    qint64                    _budget;        // 字节预算（0 表示不限制）
+    QTimer                   *_checkTimer;    // 预算检查定时器（单次，运行中表示已安排检查）
+    bool                      _exceeded;      // 上一次检查后是否仍超出预算（只在进入超出状态时发出信号）
+    quint64                   _evictions;     // 因超出预算而释放缓冲区的次数
+    qint64                    _releasedBytes; // 累计释放的字节数
+};
+
+} // namespace Mel
+
+#endif // MEL_PIXELBUDGET_H
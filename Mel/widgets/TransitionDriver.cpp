@@ -0,0 +1,170 @@
+/**
+ * @file TransitionDriver.cpp
+ * @brief 过渡动画驱动器实现
+ */
+
+#include "TransitionDriver.h"
+#include <QEvent>
+#include <QScreen>
+#include <QTimer>
+#include <QWidget>
+#include <QWindow>
+#include <QtMath>
+
+namespace Mel {
+
+TransitionDriver::TransitionDriver(QWidget *target) :
+    QObject(target), _target(target), _fallbackTimer(nullptr), _lastFrameNs(0), _easingCurve(QEasingCurve::InOutQuad)
+  , _duration(300), _frameBudget(0.0), _running(false), _framePending(false), _frameEmitted(false), _finishPending(false)
+{
+    _fallbackTimer = new QTimer(this);
+    _fallbackTimer->setSingleShot(true);
+    _fallbackTimer->setTimerType(Qt::PreciseTimer);
+    connect(_fallbackTimer, &QTimer::timeout, this, [this]() {
+        // 最后一帧已呈现，或控件没有重绘（如隐藏）时兜底结束
+        if (_finishPending) {
+            finish();
+            return;
+        }
+        _framePending = false;
+        advance();
+    });
+}
+
+TransitionDriver::~TransitionDriver() {
+    if (_window) {
+        _window->removeEventFilter(this);
+    }
+}
+
+void TransitionDriver::start() {
+    _stats         = TransitionStats();
+    _running       = true;
+    _framePending  = false;
+    _finishPending = false;
+    _lastFrameNs   = 0;
+    _clock.start();
+
+    Q_EMIT progressChanged(_easingCurve.valueForProgress(0.0));
+    _frameEmitted = true;
+    scheduleFrame();
+}
+
+void TransitionDriver::stop() {
+    _running       = false;
+    _framePending  = false;
+    _frameEmitted  = false;
+    _finishPending = false;
+    _fallbackTimer->stop();
+}
+
+void TransitionDriver::framePresented() {
+    if (!_frameEmitted) {
+        return;
+    }
+    _frameEmitted = false;
+    ++_stats.framesRendered;
+
+    // 不在 paintEvent 中发出 finished，回到事件循环后再结束
+    if (_finishPending) {
+        _fallbackTimer->start(0);
+    }
+}
+
+double TransitionDriver::getFrameBudget() const {
+    if (_frameBudget > 0.0) {
+        return _frameBudget;
+    }
+
+    // 按目标控件所在屏幕的刷新率计算
+    const QScreen *screen  = _target ? _target->screen() : nullptr;
+    const qreal    refresh = screen ? screen->refreshRate() : 60.0;
+    return 1000.0 / (refresh > 1.0 ? refresh : 60.0);
+}
+
+bool TransitionDriver::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == _window && event->type() == QEvent::UpdateRequest && _framePending) {
+        _framePending = false;
+        _fallbackTimer->stop();
+        advance();
+        // 只观察不拦截：同一窗口上的其他 requestUpdate 使用者（其他控件的驱动器、QOpenGLWidget、后备存储刷新）仍需收到
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void TransitionDriver::scheduleFrame() {
+    if (!_running || _framePending) {
+        return;
+    }
+
+    _framePending       = true;
+    const double budget = getFrameBudget();
+    if (QWindow *window = attachWindow()) {
+        // 跟随窗口的帧呈现节奏：上一帧呈现之前不会收到新的 UpdateRequest
+        window->requestUpdate();
+        // 窗口停止呈现（如最小化）时仍要推进到结束，定时器只作为兜底
+        _fallbackTimer->start(qMax(1, qRound(budget * 4)));
+        return;
+    }
+    _fallbackTimer->start(qMax(1, qRound(budget)));
+}
+
+void TransitionDriver::advance() {
+    if (!_running) {
+        return;
+    }
+
+    // 帧间隔超出预算时，中间本应绘制的帧全部跳过（进度按实际时间直接前进）
+    const qint64 nowNs   = _clock.nsecsElapsed();
+    const double frameMs = static_cast<double>(nowNs - _lastFrameNs) / 1e6;
+    const double budget  = getFrameBudget();
+    _stats.worstFrameMs  = qMax(_stats.worstFrameMs, frameMs);
+    if (frameMs > budget * 1.5) {
+        _stats.framesDropped += qMax(0, qRound(frameMs / budget) - 1);
+    }
+    _lastFrameNs = nowNs;
+
+    const double elapsedMs = static_cast<double>(nowNs) / 1e6;
+    const qreal  linear    = _duration > 0 ? qMin(1.0, elapsedMs / _duration) : 1.0;
+
+    _stats.elapsedMs = elapsedMs;
+    Q_EMIT progressChanged(_easingCurve.valueForProgress(linear));
+    _frameEmitted = true;
+
+    if (linear >= 1.0) {
+        // 等最后一帧呈现后再结束；控件不重绘时由定时器兜底
+        _running       = false;
+        _finishPending = true;
+        _fallbackTimer->start(qMax(1, qRound(budget * 4)));
+        return;
+    }
+    scheduleFrame();
+}
+
+void TransitionDriver::finish() {
+    _finishPending = false;
+    _frameEmitted  = false;
+    _fallbackTimer->stop();
+    Q_EMIT finished();
+}
+
+QWindow *TransitionDriver::attachWindow() {
+    if (!_target) {
+        return nullptr;
+    }
+
+    QWindow *window = _target->window()->windowHandle();
+    if (window != _window) {
+        // 控件被移动到了其他窗口
+        if (_window) {
+            _window->removeEventFilter(this);
+        }
+        _window = window;
+        if (_window) {
+            _window->installEventFilter(this);
+        }
+    }
+    return _target->isVisible() ? window : nullptr;
+}
+
+} // namespace Mel
@@ -0,0 +1,160 @@
+/**
+ * @file TransitionDriver.h
+ * @brief 过渡动画驱动器 - 按窗口的帧呈现节奏推进动画，并统计掉帧
+ */
+
+#ifndef MEL_TRANSITIONDRIVER_H
+#define MEL_TRANSITIONDRIVER_H
+
+#include "Mel_export.h"
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+
+class QTimer;
+class QWidget;
+class QWindow;
+
+namespace Mel {
+
+/**
+ * @brief 一次过渡动画的统计
+ */
+struct TransitionStats {
+    int    framesRendered = 0;   // 实际呈现的帧数（由 framePresented 统计）
+    int    framesDropped  = 0;   // 超出帧预算而跳过的帧数
+    double worstFrameMs   = 0.0; // 最长的帧间隔（毫秒）
+    double elapsedMs      = 0.0; // 动画实际耗时（毫秒）
+};
+
+/**
+ * @brief 过渡动画驱动器
+ *
+ * 与 QPropertyAnimation 按固定定时器推进不同，驱动器通过 QWindow::requestUpdate 跟随窗口的帧呈现节奏，
+ * 上一帧呈现之前不会再请求新的一帧；进度按实际经过的时间计算，某一帧超出预算时直接跳到当前时间对应的进度，
+ * 动画不会因为帧堆积而超过设定的时长。控件尚未关联原生窗口时退回到按帧预算间隔的定时器
+ */
+class MEL_EXPORT TransitionDriver : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 构造驱动器
+     * @param target 需要重绘的控件（用于找到所在的窗口）
+     */
+    explicit TransitionDriver(QWidget *target);
+
+    ~TransitionDriver() override;
+
+    /**
+     * @brief 开始动画（正在运行时从头开始）
+     */
+    void start();
+
+    /**
+     * @brief 停止动画（不发出 finished 信号）
+     */
+    void stop();
+
+    /**
+     * @brief 通知已呈现一帧（由目标控件的 paintEvent 调用）
+     *
+     * 只有发出 progressChanged 之后真正绘制出来的帧才计入统计；最后一帧呈现之后才发出 finished
+     */
+    void framePresented();
+
+    /**
+     * @brief 是否正在运行
+     */
+    [[nodiscard]] bool isRunning() const { return _running; }
+
+    /**
+     * @brief 设置动画时长
+     * @param msec 时长（毫秒）
+     */
+    void setDuration(int msec) { _duration = qMax(0, msec); }
+
+    /**
+     * @brief 获取动画时长（毫秒）
+     */
+    [[nodiscard]] int getDuration() const { return _duration; }
+
+    /**
+     * @brief 设置缓动曲线（默认 InOutQuad）
+     */
+    void setEasingCurve(const QEasingCurve &curve) { _easingCurve = curve; }
+
+    /**
+     * @brief 获取缓动曲线
+     */
+    [[nodiscard]] QEasingCurve getEasingCurve() const { return _easingCurve; }
+
+    /**
+     * @brief 设置帧预算
+     * @param msec 每帧的预算（毫秒），设为0时按屏幕刷新率计算（默认）
+     */
+    void setFrameBudget(double msec) { _frameBudget = qMax(0.0, msec); }
+
+    /**
+     * @brief 获取当前使用的帧预算（毫秒）
+     */
+    [[nodiscard]] double getFrameBudget() const;
+
+    /**
+     * @brief 获取当前（或最近一次）动画的统计
+     */
+    [[nodiscard]] TransitionStats getStats() const { return _stats; }
+
+Q_SIGNALS:
+    /**
+     * @brief 进度变化（已应用缓动曲线，0.0-1.0）
+     */
+    void progressChanged(qreal progress);
+
+    /**
+     * @brief 动画完成
+     */
+    void finished();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief 请求下一帧（已有未完成的请求时忽略）
+     */
+    void scheduleFrame();
+
+    /**
+     * @brief 推进一帧
+     */
+    void advance();
+
+    /**
+     * @brief 关联目标控件当前所在的窗口
+     */
+    QWindow *attachWindow();
+
+    /**
+     * @brief 结束动画并发出 finished
+     */
+    void finish();
+
+    QPointer<QWidget> _target;         // 需要重绘的控件
+    QPointer<QWindow> _window;         // 已安装事件过滤器的窗口
+    QTimer           *_fallbackTimer;  // 没有原生窗口时的定时器
+    QElapsedTimer     _clock;          // 动画计时
+    qint64            _lastFrameNs;    // 上一帧的时间（纳秒）
+    QEasingCurve      _easingCurve;    // 缓动曲线
+    int               _duration;       // 动画时长（毫秒）
+    double            _frameBudget;    // 帧预算（毫秒，0 表示按刷新率）
+    bool              _running;        // 是否正在运行
+    bool              _framePending;   // 是否有未完成的帧请求
+    bool              _frameEmitted;   // 是否已发出进度但尚未呈现
+    bool              _finishPending;  // 最后一帧已发出，等待呈现后结束
+    TransitionStats   _stats;          // 统计
+};
+
+} // namespace Mel
+
+#endif // MEL_TRANSITIONDRIVER_H
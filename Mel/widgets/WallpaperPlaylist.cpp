@@ -0,0 +1,307 @@
+/**
+ * @file WallpaperPlaylist.cpp
+ * @brief 壁纸轮播实现
+ */
+
+#include "WallpaperPlaylist.h"
+#include "core/Logging.h"
+#include <QEvent>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <algorithm>
+#include <numeric>
+
+namespace Mel {
+
+namespace {
+
+/**
+ * @brief 控件尺寸停止变化多久之后按新尺寸重新准备（毫秒）
+ */
+constexpr int kRefreshDelay = 300;
+
+} // namespace
+
+WallpaperPlaylist::WallpaperPlaylist(BackgroundWidget *widget, QObject *parent) :
+    QObject(parent ? parent : widget), _widget(widget), _position(-1), _playOrder(PlaylistOrder_Sequential), _prefetchDepth(1), _timer(nullptr), _refreshTimer(nullptr), _generation(0)
+{
+    _timer = new QTimer(this);
+    _timer->setInterval(10000);
+    connect(_timer, &QTimer::timeout, this, &WallpaperPlaylist::next);
+
+    // 调整大小期间不重复准备，停下来之后在后台按新尺寸重新缩放
+    _refreshTimer = new QTimer(this);
+    _refreshTimer->setSingleShot(true);
+    _refreshTimer->setInterval(kRefreshDelay);
+    connect(_refreshTimer, &QTimer::timeout, this, &WallpaperPlaylist::prefetch);
+
+    if (_widget) {
+        _widget->installEventFilter(this);
+    }
+}
+
+WallpaperPlaylist::~WallpaperPlaylist() = default;
+
+// ========== 播放列表 ==========
+
+void WallpaperPlaylist::setPaths(const QStringList &paths) {
+    _paths = paths;
+    _position = -1;
+    ++_generation;
+    _ready.clear();
+    _pending.clear();
+    rebuildOrder();
+}
+
+void WallpaperPlaylist::setOrder(const PlaylistOrder order) {
+    if (_playOrder == order) {
+        return;
+    }
+
+    // 从当前壁纸开始按新的顺序继续
+    const int current = getCurrentIndex();
+    _playOrder = order;
+    rebuildOrder();
+    if (current >= 0) {
+        _position = static_cast<int>(_order.indexOf(current));
+    }
+    prefetch();
+}
+
+void WallpaperPlaylist::setInterval(const int msec) {
+    _timer->setInterval(qMax(1, msec));
+}
+
+int WallpaperPlaylist::getInterval() const {
+    return _timer->interval();
+}
+
+void WallpaperPlaylist::setPrefetchDepth(const int depth) {
+    _prefetchDepth = qMax(0, depth);
+    prefetch();
+}
+
+// ========== 播放控制 ==========
+
+void WallpaperPlaylist::start() {
+    if (_paths.isEmpty()) {
+        return;
+    }
+
+    if (_position < 0) {
+        step(1);
+    } else {
+        prefetch();
+    }
+    _timer->start();
+}
+
+void WallpaperPlaylist::stop() {
+    _timer->stop();
+}
+
+bool WallpaperPlaylist::isRunning() const {
+    return _timer->isActive();
+}
+
+void WallpaperPlaylist::next() {
+    step(1);
+}
+
+void WallpaperPlaylist::previous() {
+    step(-1);
+}
+
+void WallpaperPlaylist::setCurrentIndex(const int index) {
+    if (index < 0 || index >= _paths.size()) {
+        return;
+    }
+
+    _position = static_cast<int>(_order.indexOf(index));
+    show(index);
+}
+
+int WallpaperPlaylist::getCurrentIndex() const {
+    return _position >= 0 && _position < _order.size() ? _order[_position] : -1;
+}
+
+bool WallpaperPlaylist::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == _widget.data() && event->type() == QEvent::Resize && !_ready.isEmpty()) {
+        _refreshTimer->start();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+// ========== 私有方法 ==========
+
+void WallpaperPlaylist::rebuildOrder() {
+    _order = makeCycle(-1);
+    _nextOrder.clear();
+}
+
+QVector<int> WallpaperPlaylist::makeCycle(const int previousIndex) const {
+    QVector<int> order(static_cast<int>(_paths.size()));
+    std::iota(order.begin(), order.end(), 0);
+
+    if (_playOrder == PlaylistOrder_Shuffle && order.size() > 1) {
+        std::shuffle(order.begin(), order.end(), *QRandomGenerator::global());
+        // 避免跨轮时连续两次显示同一张
+        if (order.first() == previousIndex) {
+            std::swap(order.first(), order.last());
+        }
+    }
+    return order;
+}
+
+int WallpaperPlaylist::indexAt(const int offset) {
+    const int count = static_cast<int>(_order.size());
+    if (count == 0) {
+        return -1;
+    }
+
+    const int position = _position + offset;
+    if (position >= 0 && position < count) {
+        return _order[position];
+    }
+    if (_playOrder == PlaylistOrder_Sequential) {
+        return _order[((position % count) + count) % count];
+    }
+
+    // 随机模式跨轮：向后使用下一轮的顺序，向前停在本轮开头
+    if (position < 0) {
+        return _order.first();
+    }
+    if (_nextOrder.isEmpty()) {
+        _nextOrder = makeCycle(_order.last());
+    }
+    return _nextOrder[(position - count) % count];
+}
+
+void WallpaperPlaylist::step(const int offset) {
+    const int count = static_cast<int>(_order.size());
+    if (count == 0) {
+        return;
+    }
+
+    const int index = indexAt(offset);
+    int       position = _position + offset;
+    if (position >= count) {
+        // 进入下一轮
+        if (_playOrder == PlaylistOrder_Shuffle) {
+            _order = _nextOrder.isEmpty() ? makeCycle(_order.last()) : _nextOrder;
+            _nextOrder.clear();
+        }
+        position %= count;
+    } else if (position < 0) {
+        position = _playOrder == PlaylistOrder_Shuffle ? 0 : ((position % count) + count) % count;
+    }
+
+    _position = position;
+    show(index);
+}
+
+void WallpaperPlaylist::show(const int index) {
+    if (!_widget || index < 0 || index >= _paths.size()) {
+        return;
+    }
+
+    // 手动切换后重新开始计时
+    if (_timer->isActive()) {
+        _timer->start();
+    }
+
+    const QString path = _paths[index];
+    ++_stats.switches;
+
+    auto       ready = _ready.find(path);
+    const bool hit   = ready != _ready.end();
+    if (hit) {
+        ++_stats.prefetchHits;
+        if (!_widget->isPreparedFor(*ready)) {
+            // 准备之后控件尺寸或缩放设置发生了变化，只复用解码结果
+            ++_stats.staleScales;
+        }
+        const PreparedBackground prepared = *ready;
+        _ready.erase(ready);
+        _widget->setPreparedBackground(prepared);
+    } else {
+        ++_stats.prefetchMisses;
+        _widget->setBackgroundImage(path);
+    }
+
+    qCDebug(lcMel) << "WallpaperPlaylist: 切换到:" << path << (hit ? "（已预取）" : "（未预取）");
+    Q_EMIT currentChanged(index, path, hit);
+
+    prefetch();
+}
+
+void WallpaperPlaylist::prefetch() {
+    if (!_widget || _paths.isEmpty()) {
+        return;
+    }
+
+    // 接下来需要的壁纸（不包括当前这张）
+    QSet<QString> wanted;
+    const int     depth = qMin(_prefetchDepth, static_cast<int>(_paths.size()) - 1);
+    for (int offset = 1; offset <= depth; ++offset) {
+        const int index = indexAt(offset);
+        if (index >= 0) {
+            wanted.insert(_paths[index]);
+        }
+    }
+
+    // 丢弃不再需要的结果
+    for (auto it = _ready.begin(); it != _ready.end();) {
+        if (!wanted.contains(it.key())) {
+            it = _ready.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const QString &path : wanted) {
+        if (_pending.contains(path)) {
+            continue;
+        }
+
+        auto ready = _ready.find(path);
+        if (ready != _ready.end() && _widget->isPreparedFor(*ready)) {
+            continue;
+        }
+
+        _pending.insert(path);
+        auto done = [this, path, generation = _generation](const PreparedBackground &prepared) { onPrepared(path, generation, prepared); };
+        if (ready != _ready.end()) {
+            // 按旧尺寸或旧缩放设置准备的结果：复用解码结果在后台重新缩放，完成前切换到这张仍可使用旧的结果
+            _widget->rescalePrepared(*ready, this, done);
+        } else {
+            _widget->prepareBackground(path, this, done);
+        }
+    }
+}
+
+void WallpaperPlaylist::onPrepared(const QString &path, const quint64 generation, const PreparedBackground &prepared) {
+    if (generation != _generation) {
+        return;
+    }
+    _pending.remove(path);
+    if (prepared.image.isNull()) {
+        // 准备失败时切换到这张会现场加载并报告错误
+        return;
+    }
+
+    // 准备期间当前位置可能已经变化，只保留仍然需要的结果
+    for (int offset = 1; offset <= _prefetchDepth; ++offset) {
+        const int index = indexAt(offset);
+        if (index >= 0 && _paths[index] == path) {
+            _ready.insert(path, prepared);
+            // 准备期间控件尺寸又变了：尺寸稳定后再缩放一次
+            if (_widget && !_widget->isPreparedFor(prepared) && !_refreshTimer->isActive()) {
+                _refreshTimer->start();
+            }
+            return;
+        }
+    }
+}
+
+} // namespace Mel
@@ -0,0 +1,224 @@
+/**
+ * @file WallpaperPlaylist.h
+ * @brief 壁纸轮播 - 按间隔切换 BackgroundWidget 的背景，并提前在后台准备接下来的壁纸
+ */
+
+#ifndef MEL_WALLPAPERPLAYLIST_H
+#define MEL_WALLPAPERPLAYLIST_H
+
+#include "Mel_export.h"
+#include "BackgroundWidget.h"
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+class QTimer;
+
+namespace Mel {
+
+/**
+ * @brief 轮播顺序
+ */
+enum PlaylistOrder {
+    PlaylistOrder_Sequential = 0, // 顺序播放
+    PlaylistOrder_Shuffle    = 1  // 随机播放（每轮打乱一次，一轮内不重复）
+};
+
+/**
+ * @brief 轮播统计
+ */
+struct PlaylistStats {
+    int switches       = 0; // 切换次数
+    int prefetchHits   = 0; // 使用预先准备好的图片切换的次数
+    int prefetchMisses = 0; // 切换时尚未准备好、需要现场解码的次数
+    int staleScales    = 0; // 预先准备时的控件尺寸或缩放设置已变化、只复用了解码结果的次数
+};
+
+/**
+ * @brief 壁纸轮播
+ *
+ * 按设定的间隔和顺序切换 BackgroundWidget 的背景图片。每次切换后，在后台线程中提前解码
+ * 并按控件当前尺寸缩放接下来的若干张壁纸（预取深度），定时切换时过渡动画直接从准备好的图片开始，
+ * 不会因为解码和缩放而卡顿。控件调整大小停止后，已准备的壁纸在后台按新尺寸重新缩放（复用解码结果）
+ */
+class MEL_EXPORT WallpaperPlaylist : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief 构造轮播
+     * @param widget 要切换背景的控件
+     * @param parent 父对象（为空时以控件作为父对象）
+     */
+    explicit WallpaperPlaylist(BackgroundWidget *widget, QObject *parent = nullptr);
+
+    ~WallpaperPlaylist() override;
+
+    // ========== 播放列表 ==========
+
+    /**
+     * @brief 设置壁纸路径列表（丢弃已准备的图片，当前位置重置）
+     * @param paths 图片路径（支持 :/ 资源路径）
+     */
+    void setPaths(const QStringList &paths);
+
+    /**
+     * @brief 获取壁纸路径列表
+     */
+    [[nodiscard]] QStringList getPaths() const { return _paths; }
+
+    /**
+     * @brief 设置轮播顺序
+     */
+    void setOrder(PlaylistOrder order);
+
+    /**
+     * @brief 获取轮播顺序
+     */
+    [[nodiscard]] PlaylistOrder getOrder() const { return _playOrder; }
+
+    /**
+     * @brief 设置切换间隔
+     * @param msec 间隔（毫秒），默认10000
+     */
+    void setInterval(int msec);
+
+    /**
+     * @brief 获取切换间隔（毫秒）
+     */
+    [[nodiscard]] int getInterval() const;
+
+    /**
+     * @brief 设置预取深度
+     * @param depth 提前准备的壁纸数量，默认1，设为0禁用预取
+     */
+    void setPrefetchDepth(int depth);
+
+    /**
+     * @brief 获取预取深度
+     */
+    [[nodiscard]] int getPrefetchDepth() const { return _prefetchDepth; }
+
+    // ========== 播放控制 ==========
+
+    /**
+     * @brief 开始定时切换（尚未显示任何壁纸时立即显示第一张）
+     */
+    void start();
+
+    /**
+     * @brief 停止定时切换
+     */
+    void stop();
+
+    /**
+     * @brief 是否正在定时切换
+     */
+    [[nodiscard]] bool isRunning() const;
+
+    /**
+     * @brief 切换到下一张（重新开始计时）
+     */
+    void next();
+
+    /**
+     * @brief 切换到上一张（重新开始计时）
+     */
+    void previous();
+
+    /**
+     * @brief 切换到指定壁纸（重新开始计时）
+     * @param index 在路径列表中的序号
+     */
+    void setCurrentIndex(int index);
+
+    /**
+     * @brief 获取当前壁纸在路径列表中的序号（尚未显示时为 -1）
+     */
+    [[nodiscard]] int getCurrentIndex() const;
+
+    // ========== 统计 ==========
+
+    /**
+     * @brief 获取轮播统计
+     */
+    [[nodiscard]] PlaylistStats getStats() const { return _stats; }
+
+    /**
+     * @brief 清零轮播统计
+     */
+    void resetStats() { _stats = PlaylistStats(); }
+
+    /**
+     * @brief 指定壁纸是否已经准备好
+     */
+    [[nodiscard]] bool isPrefetched(const QString &path) const { return _ready.contains(path); }
+
+Q_SIGNALS:
+    /**
+     * @brief 当前壁纸已切换
+     * @param index 在路径列表中的序号
+     * @param path 图片路径
+     * @param prefetched 是否使用了预先准备好的图片
+     */
+    void currentChanged(int index, const QString &path, bool prefetched);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    /**
+     * @brief 重新生成播放顺序
+     */
+    void rebuildOrder();
+
+    /**
+     * @brief 生成一轮播放顺序（随机模式下避免与上一轮最后一张重复）
+     */
+    [[nodiscard]] QVector<int> makeCycle(int previousIndex) const;
+
+    /**
+     * @brief 获取从当前位置往后第 offset 张壁纸的序号（跨越一轮时使用下一轮的顺序）
+     */
+    [[nodiscard]] int indexAt(int offset);
+
+    /**
+     * @brief 移动到从当前位置往后第 offset 张（可为负数）并显示
+     */
+    void step(int offset);
+
+    /**
+     * @brief 显示指定壁纸
+     */
+    void show(int index);
+
+    /**
+     * @brief 在后台准备接下来的壁纸（按旧尺寸准备的结果在后台重新缩放），并丢弃不再需要的结果
+     */
+    void prefetch();
+
+    /**
+     * @brief 一张壁纸准备完成
+     */
+    void onPrepared(const QString &path, quint64 generation, const PreparedBackground &prepared);
+
+    QPointer<BackgroundWidget>         _widget;        // 要切换背景的控件
+    QStringList                        _paths;         // 壁纸路径
+    QVector<int>                       _order;         // 本轮播放顺序（路径序号）
+    QVector<int>                       _nextOrder;     // 下一轮播放顺序（随机模式下预取跨轮时生成）
+    int                                _position;      // 当前在本轮中的位置（尚未显示时为 -1）
+    PlaylistOrder                      _playOrder;     // 轮播顺序
+    int                                _prefetchDepth; // 预取深度
+    QTimer                            *_timer;         // 切换定时器
+    QTimer                            *_refreshTimer;  // 控件尺寸稳定后重新准备的定时器
+    QHash<QString, PreparedBackground> _ready;         // 已准备好的壁纸
+    QSet<QString>                      _pending;       // 正在准备的壁纸
+    quint64                            _generation;    // 列表变化时递增，丢弃过期的准备结果
+    PlaylistStats                      _stats;         // 统计
+};
+
+} // namespace Mel
+
+#endif // MEL_WALLPAPERPLAYLIST_H
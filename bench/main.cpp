@@ -0,0 +1,278 @@
+/**
+ * @file main.cpp
+ * @brief Mel 性能基准
+ *
+ * 对每张内置壁纸在多个控件尺寸下测量：解码、各缩放模式和缩放质量下的重新缩放、
+ * 稳定状态的整体绘制与局部绘制、过渡动画每一帧的绘制。默认使用 offscreen 平台无界面运行，
+ * 结果以 JSON 输出，便于比较不同构建（Qt 版本、编译选项、代码改动）之间的差异
+ *
+ * 用法：Mel_bench [-o results.json] [-n 迭代次数] [-f 壁纸名过滤]
+ */
+
+#include "image/ImageCache.h"
+#include "image/ImageLoader.h"
+#include "image/Resampler.h"
+#include "widgets/BackgroundWidget.h"
+#include "Mel.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegion>
+#include <QSysInfo>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 内置壁纸（与 Mel.qrc 保持一致）
+ */
+const char *const kWallpapers[] = {
+        ":/Mel/res/wallpaper/1k/supernova.jpg",
+        ":/Mel/res/wallpaper/2k/mountain&lake.png",
+        ":/Mel/res/wallpaper/2k/Sunshine&Maple_Forest.jpg",
+        ":/Mel/res/wallpaper/4k/doomsday&power_station.jpg",
+        ":/Mel/res/wallpaper/4k/road&sakuar&inverted_image.png",
+        ":/Mel/res/wallpaper/4k/room&window.png",
+};
+
+/**
+ * @brief 测量的控件尺寸
+ */
+const QSize kWidgetSizes[] = {{1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}};
+
+struct ScaleModeInfo {
+    Mel::BackgroundScaleMode mode;
+    const char              *name;
+};
+
+const ScaleModeInfo kScaleModes[] = {{Mel::ScaleMode_Fill, "fill"}, {Mel::ScaleMode_Fit, "fit"}, {Mel::ScaleMode_Stretch, "stretch"}};
+
+struct ScaleQualityInfo {
+    Mel::ScaleQuality quality;
+    const char       *name;
+};
+
+const ScaleQualityInfo kScaleQualities[] = {
+        {Mel::ScaleQuality_Nearest, "nearest"}, {Mel::ScaleQuality_Bilinear, "bilinear"}, {Mel::ScaleQuality_Area, "area"}, {Mel::ScaleQuality_Lanczos3, "lanczos3"}};
+
+/**
+ * @brief 一组耗时样本（毫秒）
+ */
+class Samples {
+public:
+    void add(const double ms) { _values.push_back(ms); }
+
+    /**
+     * @brief 计时执行一次
+     */
+    void time(const std::function<void()> &work) {
+        QElapsedTimer timer;
+        timer.start();
+        work();
+        add(static_cast<double>(timer.nsecsElapsed()) / 1e6);
+    }
+
+    [[nodiscard]] double median() const {
+        if (_values.empty()) {
+            return 0.0;
+        }
+        std::vector<double> sorted = _values;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t middle = sorted.size() / 2;
+        return sorted.size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2.0;
+    }
+
+    [[nodiscard]] QJsonObject toJson() const {
+        double sum = 0.0;
+        for (const double value : _values) {
+            sum += value;
+        }
+        const auto [minimum, maximum] = std::minmax_element(_values.begin(), _values.end());
+        return {
+                {"median_ms", median()},
+                {"mean_ms", _values.empty() ? 0.0 : sum / static_cast<double>(_values.size())},
+                {"min_ms", _values.empty() ? 0.0 : *minimum},
+                {"max_ms", _values.empty() ? 0.0 : *maximum},
+                {"samples", static_cast<int>(_values.size())},
+        };
+    }
+
+private:
+    std::vector<double> _values;
+};
+
+/**
+ * @brief 重复绘制指定区域
+ */
+Samples measurePaint(QWidget &widget, QImage &target, const QRegion &region, const int iterations) {
+    const QPoint offset = region.boundingRect().topLeft();
+    widget.render(&target, offset, region); // 预热（包括图层合成）
+
+    Samples samples;
+    for (int i = 0; i < iterations; ++i) {
+        samples.time([&]() { widget.render(&target, offset, region); });
+    }
+    return samples;
+}
+
+/**
+ * @brief 测量一张壁纸在一个控件尺寸下的缩放和绘制
+ */
+QJsonObject measureSize(const QString &path, const QString &nextPath, const QSize &size, const int iterations) {
+    Mel::BackgroundWidget widget;
+    widget.setTransitionDuration(0);
+    widget.setInteractiveResize(false);
+    widget.setMipmapsEnabled(false); // 金字塔在后台异步构建，关闭以保证每次测量的工作量相同
+    widget.resize(size);
+    widget.setBackgroundImage(path);
+
+    QJsonObject result{{"width", size.width()}, {"height", size.height()}};
+
+    // 重新缩放：每次切换缩放质量都会执行一次完整的缩放
+    QJsonObject rescale;
+    for (const ScaleModeInfo &mode : kScaleModes) {
+        widget.setScaleMode(mode.mode);
+
+        Samples perQuality[std::size(kScaleQualities)];
+        for (int i = 0; i < iterations; ++i) {
+            for (size_t q = 0; q < std::size(kScaleQualities); ++q) {
+                perQuality[q].time([&]() { widget.setScaleQuality(kScaleQualities[q].quality); });
+            }
+        }
+
+        QJsonObject qualities;
+        for (size_t q = 0; q < std::size(kScaleQualities); ++q) {
+            qualities.insert(kScaleQualities[q].name, perQuality[q].toJson());
+        }
+        rescale.insert(mode.name, qualities);
+    }
+    result.insert("rescale", rescale);
+
+    // 稳定状态绘制（默认的填满模式和区域平均缩放）
+    widget.setScaleMode(Mel::ScaleMode_Fill);
+    widget.setScaleQuality(Mel::ScaleQuality_Area);
+    QImage        target(size, QImage::Format_ARGB32_Premultiplied);
+    const QRegion full(widget.rect());
+    const QRegion cursor(QRect(size.width() / 4, size.height() / 4, 2, 20)); // 子控件局部更新（输入框光标）
+
+    result.insert("paint", measurePaint(widget, target, full, iterations).toJson());
+    result.insert("paint_region", measurePaint(widget, target, cursor, iterations).toJson());
+
+    widget.setOverlayColor(QColor(0, 0, 0, 80));
+    result.insert("paint_overlay", measurePaint(widget, target, full, iterations).toJson());
+
+    // 过渡动画的每一帧：新旧两个画面叠加，驱动器没有事件循环不会推进，手动设置透明度
+    widget.setTransitionDuration(60000);
+    widget.setBackgroundImage(nextPath);
+    Samples transition;
+    target.fill(Qt::transparent);
+    for (int i = 0; i < iterations; ++i) {
+        widget.setTransitionOpacity(static_cast<qreal>(i + 1) / (iterations + 1));
+        transition.time([&]() { widget.render(&target); });
+    }
+    result.insert("transition_frame", transition.toJson());
+
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    // 默认无界面运行
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Mel_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mel 性能基准，结果以 JSON 输出");
+    parser.addHelpOption();
+    const QCommandLineOption outputOption({"o", "output"}, "JSON 输出文件（默认输出到标准输出）", "file");
+    const QCommandLineOption iterationsOption({"n", "iterations"}, "每项测量的迭代次数（默认5）", "count", "5");
+    const QCommandLineOption filterOption({"f", "filter"}, "只测量路径包含该字符串的壁纸", "text");
+    parser.addOption(outputOption);
+    parser.addOption(iterationsOption);
+    parser.addOption(filterOption);
+    parser.process(app);
+
+    const int     iterations = qMax(1, parser.value(iterationsOption).toInt());
+    const QString filter     = parser.value(filterOption);
+
+    // 关闭进程级缓存，每次解码和缩放都真正执行
+    Mel::ImageCache::instance().setBudget(0);
+
+    QStringList wallpapers;
+    for (const char *path : kWallpapers) {
+        if (filter.isEmpty() || QString::fromUtf8(path).contains(filter)) {
+            wallpapers.append(QString::fromUtf8(path));
+        }
+    }
+
+    QJsonArray results;
+    for (int w = 0; w < wallpapers.size(); ++w) {
+        const QString &path = wallpapers[w];
+        std::fprintf(stderr, "[%d/%d] %s\n", w + 1, static_cast<int>(wallpapers.size()), qPrintable(path));
+
+        // 解码（完整原图）
+        Samples decode;
+        QImage  image;
+        for (int i = 0; i < iterations; ++i) {
+            decode.time([&]() { image = Mel::ImageLoader::load(path); });
+        }
+        if (image.isNull()) {
+            std::fprintf(stderr, "无法加载 %s\n", qPrintable(path));
+            continue;
+        }
+
+        QJsonObject wallpaper{
+                {"path", path},
+                {"source_width", image.width()},
+                {"source_height", image.height()},
+                {"decode", decode.toJson()},
+        };
+
+        // 过渡动画切换到下一张壁纸
+        const QString &nextPath = wallpapers[(w + 1) % wallpapers.size()];
+        QJsonArray     sizes;
+        for (const QSize &size : kWidgetSizes) {
+            sizes.append(measureSize(path, nextPath, size, iterations));
+        }
+        wallpaper.insert("sizes", sizes);
+        results.append(wallpaper);
+    }
+
+    const QJsonObject report{
+            {"mel_version", Mel::MelLib::getVersion()},
+            {"qt_version", QString::fromLatin1(qVersion())},
+            {"platform", QGuiApplication::platformName()},
+            {"cpu", QSysInfo::currentCpuArchitecture()},
+            {"simd", static_cast<int>(Mel::Resampler::detectSimdLevel())},
+            {"iterations", iterations},
+            {"wallpapers", results},
+    };
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::fprintf(stderr, "无法写入 %s\n", qPrintable(file.fileName()));
+            return 1;
+        }
+        file.write(json);
+        return 0;
+    }
+
+    std::fwrite(json.constData(), 1, static_cast<size_t>(json.size()), stdout);
+    return 0;
+}
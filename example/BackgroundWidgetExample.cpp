@@ -3,8 +3,13 @@
 #include "ElaComboBox.h"
 #include "ui_BackgroundWidgetExample.h"
 
+#include <QCheckBox>
 #include <QColorDialog>
+#include <QDebug>
+#include <QFileDialog>
+#include <QLinearGradient>
 #include <QPushButton>
+#include <QSignalBlocker>
 
 BackgroundWidgetExample::BackgroundWidgetExample(QWidget *parent) :
     QWidget(parent), ui(new Ui::BackgroundWidgetExample) {
@@ -23,6 +28,7 @@ void BackgroundWidgetExample::initUi() {
     backgroundWidget = new Mel::BackgroundWidget(this);
     backgroundWidget->setScaleMode(Mel::ScaleMode_Fill);
     backgroundWidget->setTransitionDuration(500);
+    backgroundWidget->setLoadMode(Mel::LoadMode_Async); // 在后台线程解码，切换 4K 壁纸时不阻塞界面
     mainLayout->addWidget(backgroundWidget);
 
 
@@ -51,6 +57,22 @@ void BackgroundWidgetExample::initUi() {
     connect(comboBoxResourcePath, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &BackgroundWidgetExample::onWallpaperChanged);
 
+    // 轮播：提前在后台解码并缩放下一张壁纸，切换时直接从准备好的图片开始过渡
+    QStringList paths;
+    for (const auto &wallpaper: _wallpapers) {
+        paths.append(wallpaper.path);
+    }
+    playlist = new Mel::WallpaperPlaylist(backgroundWidget, this);
+    playlist->setPaths(paths);
+    playlist->setInterval(10000);
+    playlist->setPrefetchDepth(1);
+    connect(playlist, &Mel::WallpaperPlaylist::currentChanged, this, [this](const int index, const QString &, const bool prefetched) {
+        const QSignalBlocker blocker(comboBoxResourcePath);
+        comboBoxResourcePath->setCurrentIndex(index);
+        const Mel::PlaylistStats stats = playlist->getStats();
+        qDebug() << "BackgroundWidgetExample: 切换壁纸" << (prefetched ? "命中预取" : "未命中预取") << "累计命中" << stats.prefetchHits << "/" << stats.switches;
+    });
+
     mainLayout->addWidget(widgetPanel);
 
     comboBoxMode = new QComboBox(this);
@@ -66,6 +88,63 @@ void BackgroundWidgetExample::initUi() {
     auto colorButton = new QPushButton("选择背景色", this);
     layout->addWidget(colorButton);
     connect(colorButton, &QPushButton::clicked, this, &BackgroundWidgetExample::onSelectBackgroundColor);
+
+    auto slideshowCheckBox = new QCheckBox("自动轮播（10秒）", this);
+    layout->addWidget(slideshowCheckBox);
+    connect(slideshowCheckBox, &QCheckBox::toggled, this, [this](const bool enabled) {
+        if (enabled) {
+            playlist->start();
+        } else {
+            playlist->stop();
+        }
+    });
+
+    auto shuffleCheckBox = new QCheckBox("随机顺序", this);
+    layout->addWidget(shuffleCheckBox);
+    connect(shuffleCheckBox, &QCheckBox::toggled, this, [this](const bool enabled) {
+        playlist->setOrder(enabled ? Mel::PlaylistOrder_Shuffle : Mel::PlaylistOrder_Sequential);
+    });
+
+    auto gradientCheckBox = new QCheckBox("底部可读性渐变", this);
+    layout->addWidget(gradientCheckBox);
+    connect(gradientCheckBox, &QCheckBox::toggled, this, &BackgroundWidgetExample::onReadabilityGradientToggled);
+
+    // 毛玻璃：每张壁纸只在后台模糊一次
+    auto blurCheckBox = new QCheckBox("毛玻璃", this);
+    layout->addWidget(blurCheckBox);
+    connect(blurCheckBox, &QCheckBox::toggled, this, [this](const bool enabled) { backgroundWidget->setBlurRadius(enabled ? 32 : 0); });
+
+    // 平移缩放：只预先缩放一次，每帧移动源矩形
+    auto kenBurnsCheckBox = new QCheckBox("平移缩放（Ken Burns）", this);
+    layout->addWidget(kenBurnsCheckBox);
+    connect(kenBurnsCheckBox, &QCheckBox::toggled, backgroundWidget, &Mel::BackgroundWidget::setKenBurnsEnabled);
+
+    // 渐进加载：解码完成前先显示极小的预览
+    auto progressiveCheckBox = new QCheckBox("渐进加载", this);
+    layout->addWidget(progressiveCheckBox);
+    connect(progressiveCheckBox, &QCheckBox::toggled, backgroundWidget, &Mel::BackgroundWidget::setProgressiveLoading);
+
+    // 超大图片按分块显示：拖动平移，滚轮缩放
+    auto tiledButton = new QPushButton("打开超大图片（分块）", this);
+    layout->addWidget(tiledButton);
+    connect(tiledButton, &QPushButton::clicked, this, [this]() {
+        const QString path = QFileDialog::getOpenFileName(this, "选择图片", QString(), "Images (*.jpg *.jpeg *.png *.tif *.tiff *.webp)");
+        if (!path.isEmpty()) {
+            playlist->stop();
+            backgroundWidget->setTiledBackground(path);
+        }
+    });
+
+    // 动态背景：隐藏或最小化窗口时停止播放
+    auto animatedButton = new QPushButton("打开动态背景", this);
+    layout->addWidget(animatedButton);
+    connect(animatedButton, &QPushButton::clicked, this, [this]() {
+        const QString path = QFileDialog::getOpenFileName(this, "选择动画", QString(), "Animations (*.gif *.png *.apng *.webp)");
+        if (!path.isEmpty()) {
+            playlist->stop();
+            backgroundWidget->setAnimatedBackground(path);
+        }
+    });
     resize(800, 600);
 }
 
@@ -75,7 +154,7 @@ void BackgroundWidgetExample::setCurrentWallpaper(const QString &resourcePath) c
 
 void BackgroundWidgetExample::onWallpaperChanged(const int index) {
     if (index >= 0 && index < _wallpapers.size()) {
-        setCurrentWallpaper(_wallpapers[index].path);
+        playlist->setCurrentIndex(index); // 经过轮播切换，之后的壁纸也会被预取
     }
 }
 
@@ -84,6 +163,27 @@ void BackgroundWidgetExample::onModelChange(const int index) const {
     backgroundWidget->setScaleMode(mode);
 }
 
+void BackgroundWidgetExample::onReadabilityGradientToggled(const bool enabled) const {
+    if (!enabled) {
+        backgroundWidget->clearLayers(); // 恢复由背景色、图片和遮罩组成的默认图层
+        return;
+    }
+
+    // 底部 40% 逐渐变暗，所有图层合成为一张缓存，不会增加每次绘制的开销
+    QLinearGradient gradient(0.0, 0.6, 0.0, 1.0);
+    gradient.setCoordinateMode(QGradient::ObjectBoundingMode);
+    gradient.setColorAt(0.0, QColor(0, 0, 0, 0));
+    gradient.setColorAt(1.0, QColor(0, 0, 0, 160));
+
+    QList<Mel::BackgroundLayer> layers;
+    if (backgroundWidget->getBackgroundColor().isValid()) {
+        layers.append(Mel::BackgroundLayer::solid(backgroundWidget->getBackgroundColor()));
+    }
+    layers.append(Mel::BackgroundLayer::image());
+    layers.append(Mel::BackgroundLayer::gradient(gradient));
+    backgroundWidget->setLayers(layers);
+}
+
 void BackgroundWidgetExample::onSelectBackgroundColor() {
     // 获取当前背景色
     QColor currentColor = backgroundWidget->getBackgroundColor();
@@ -6,6 +6,7 @@
 
 #include "ElaComboBox.h"
 #include "widgets/BackgroundWidget.h"
+#include "widgets/WallpaperPlaylist.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -28,12 +29,14 @@ public slots:
     void onWallpaperChanged(int index);
     void onModelChange(int index) const;
     void onSelectBackgroundColor();
+    void onReadabilityGradientToggled(bool enabled) const;
 
 private:
     Ui::BackgroundWidgetExample *ui;
 
     QHBoxLayout *mainLayout = nullptr;
     Mel::BackgroundWidget *backgroundWidget = nullptr;
+    Mel::WallpaperPlaylist *playlist = nullptr;
     QWidget *widgetPanel = nullptr;
     QVBoxLayout *layout = nullptr;
     QComboBox *comboBoxResourcePath = nullptr;
@@ -4,6 +4,7 @@
 #include "mainwindow.h"
 #include "BackgroundWidgetExample.h"
 #include "widgets/ElMainWindow.h"
+#include "image/DiskCache.h"
 
 int main(int argc, char *argv[])
 {
@@ -14,6 +15,9 @@ int main(int argc, char *argv[])
     QCoreApplication::setApplicationVersion("1.0.0");
     QCoreApplication::setOrganizationName("Mel");
 
+    // 缓存缩放好的背景，再次启动时不需要解码（缓存目录依赖上面的应用程序信息）
+    Mel::DiskCache::instance().setEnabled(true);
+
     // 打印 Mel 库版本信息
     qDebug() << "=================================";
     qDebug() << "Mel 库版本:" << Mel::MelLib::getVersion();
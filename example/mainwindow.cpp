@@ -6,6 +6,7 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "Mel.h"
+#include "widgets/WallpaperPlaylist.h"
 #include <QMessageBox>
 #include <QDebug>
 #include <QColorDialog>
@@ -14,15 +15,16 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , _currentWallpaperIndex(0)
+    , _playlist(nullptr)
 {
     ui->setupUi(this);
     
     initWallpapers();
     initUi();
     
-    // 设置初始壁纸
+    // 设置初始壁纸（经过轮播切换，下一张随即在后台准备）
     if (!_wallpapers.isEmpty()) {
-        setCurrentWallpaper(_wallpapers[0].path);
+        _playlist->setCurrentIndex(0);
     }
 }
 
@@ -60,6 +62,25 @@ void MainWindow::initUi()
     // ========== 配置 BackgroundWidget ==========
     ui->backgroundWidget->setScaleMode(Mel::ScaleMode_Fill);  // 默认填满模式
     ui->backgroundWidget->setTransitionDuration(500);          // 设置背景切换动画时长为500毫秒
+    ui->backgroundWidget->setLoadMode(Mel::LoadMode_Async);    // 在后台线程解码，切换 4K 壁纸时不阻塞界面
+    connect(ui->backgroundWidget, &Mel::BackgroundWidget::loadFailed, this, [](const QString &path, const QString &errorString) {
+        qWarning() << "MainWindow: 无法设置壁纸:" << path << errorString;
+    });
+
+    // ========== 壁纸轮播 ==========
+    QStringList paths;
+    for (const auto& wallpaper : _wallpapers) {
+        paths.append(wallpaper.path);
+    }
+    _playlist = new Mel::WallpaperPlaylist(ui->backgroundWidget, this);
+    _playlist->setPaths(paths);
+    _playlist->setPrefetchDepth(1);
+    connect(_playlist, &Mel::WallpaperPlaylist::currentChanged, this, [this](int index, const QString&, bool prefetched) {
+        // 同步下拉框，不再触发切换
+        const QSignalBlocker blocker(ui->wallpaperCombo);
+        ui->wallpaperCombo->setCurrentIndex(index);
+        qDebug() << "MainWindow: 壁纸已切换:" << _wallpapers[index].displayName << (prefetched ? "（已预取）" : "（未预取）");
+    });
     
     // ========== 更新描述信息（动态版本信息）==========
     const QString melVersion = Mel::MelLib::getVersion();
@@ -103,24 +124,11 @@ void MainWindow::initUi()
             this, &MainWindow::onShowAbout);
 }
 
-void MainWindow::setCurrentWallpaper(const QString& resourcePath)
-{
-    // 使用 BackgroundWidget 设置背景图片
-    if (!ui->backgroundWidget->setBackgroundImage(resourcePath)) {
-        qWarning() << "MainWindow: 无法设置壁纸:" << resourcePath;
-        return;
-    }
-    
-    qDebug() << "MainWindow: 壁纸设置成功:" << resourcePath;
-}
-
 void MainWindow::onWallpaperChanged(int index)
 {
     if (index >= 0 && index < _wallpapers.size()) {
         _currentWallpaperIndex = index;
-        setCurrentWallpaper(_wallpapers[index].path);
-        
-        qDebug() << "MainWindow: 切换到壁纸:" << _wallpapers[index].displayName;
+        _playlist->setCurrentIndex(index);  // 准备好的下一张直接开始过渡
     }
 }
 
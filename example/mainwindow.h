@@ -12,6 +12,10 @@ namespace Ui {
 class MainWindow;
 }
 
+namespace Mel {
+class WallpaperPlaylist;
+}
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -30,7 +34,6 @@ private slots:
 private:
     void initUi();
     void initWallpapers();
-    void setCurrentWallpaper(const QString& resourcePath);
     
     Ui::MainWindow *ui;
     
@@ -43,6 +46,7 @@ private:
     
     QList<WallpaperInfo> _wallpapers;
     int _currentWallpaperIndex;
+    Mel::WallpaperPlaylist *_playlist;  // 切换壁纸并在后台预取下一张
 };
 
 #endif // MAINWINDOW_H
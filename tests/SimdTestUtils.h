@@ -0,0 +1,66 @@
+/**
+ * @file SimdTestUtils.h
+ * @brief SIMD 内核测试的公共工具 - 确定性测试图片和按每个 SIMD 级别、线程数与参考结果比较
+ */
+
+#ifndef MEL_TESTS_SIMDTESTUTILS_H
+#define MEL_TESTS_SIMDTESTUTILS_H
+
+#include "image/Resampler.h"
+#include <QtTest>
+
+namespace MelTest {
+
+/**
+ * @brief 测试图片的像素格式（数据驱动测试按名称和格式各生成一组）
+ */
+inline QList<QPair<const char *, QImage::Format>> testFormats() {
+    return {
+            {"rgb32", QImage::Format_RGB32},
+            {"argb32pm", QImage::Format_ARGB32_Premultiplied},
+    };
+}
+
+/**
+ * @brief 生成确定性的测试图片：渐变叠加伪随机噪声和 16 像素的硬边色块，预乘格式时颜色不超过 alpha
+ */
+inline QImage makeImage(const QSize &size, const QImage::Format format) {
+    QImage  image(size, format);
+    quint32 seed = 0x12345678u;
+    for (int y = 0; y < size.height(); ++y) {
+        auto *row = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < size.width(); ++x) {
+            seed = seed * 1664525u + 1013904223u;
+
+            const bool    block = ((x / 16) + (y / 16)) % 2 == 0;
+            const quint32 alpha = format == QImage::Format_ARGB32_Premultiplied ? (seed >> 24) : 0xFFu;
+            const quint32 red   = ((x * 255 / qMax(1, size.width() - 1)) ^ (seed >> 16)) & 0xFF;
+            const quint32 green = ((y * 255 / qMax(1, size.height() - 1)) ^ (seed >> 8)) & 0xFF;
+            const quint32 blue  = block ? 0xFFu : seed & 0xFF;
+            row[x]              = (alpha << 24) | ((red * alpha / 255) << 16) | ((green * alpha / 255) << 8) | (blue * alpha / 255);
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief 在当前 CPU 支持的每个 SIMD 级别上，单线程与多线程各运行一次，逐通道误差不得超过 tolerance
+ * @param reference 标量参考结果
+ * @param tolerance 允许的逐通道最大误差
+ * @param run 按 (SIMD 级别, 线程数) 计算结果
+ */
+template<typename Run>
+void verifyAllSimdLevels(const QImage &reference, const int tolerance, Run run) {
+    for (int level = Mel::Resampler::Simd_Scalar; level <= Mel::Resampler::detectSimdLevel(); ++level) {
+        for (const int threads : {1, 4}) {
+            const QImage result     = run(static_cast<Mel::Resampler::SimdLevel>(level), threads);
+            const int    difference = Mel::Resampler::maxChannelDifference(result, reference);
+            QVERIFY2(difference >= 0 && difference <= tolerance,
+                     qPrintable(QStringLiteral("SIMD level %1, %2 threads: max channel difference %3").arg(level).arg(threads).arg(difference)));
+        }
+    }
+}
+
+} // namespace MelTest
+
+#endif // MEL_TESTS_SIMDTESTUTILS_H
@@ -0,0 +1,98 @@
+/**
+ * @file tst_animatedbackground.cpp
+ * @brief AnimatedBackground 测试 - 被兄弟控件遮挡时帧时钟停止，遮挡移开后恢复
+ */
+
+#include "widgets/AnimatedBackground.h"
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QWidget>
+
+using Mel::AnimatedBackground;
+
+namespace {
+
+/**
+ * @brief 两帧 1x1 的循环 GIF（白、黑交替，每帧 100ms）
+ */
+QByteArray twoFrameGif() {
+    QByteArray gif = QByteArray::fromHex(
+        "474946383961" "01000100" "800000"      // GIF89a，1x1，2 色全局调色板
+        "ffffff" "000000"                        // 调色板：白、黑
+        "21ff0b" "4e45545343415045322e30"        // NETSCAPE2.0 应用扩展
+        "03010000" "00");                        // 无限循环
+    const QByteArray frame0 = QByteArray::fromHex("21f904000a000000" "2c000000000100010000" "0202440100");
+    const QByteArray frame1 = QByteArray::fromHex("21f904000a000000" "2c000000000100010000" "02024c0100");
+    gif += frame0;
+    gif += frame1;
+    gif += char(0x3b);                           // 文件结束
+    return gif;
+}
+
+} // namespace
+
+class TestAnimatedBackground : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void resumesAfterSiblingUncovers();
+
+private:
+    QTemporaryDir _dir;
+    QString       _path;
+};
+
+void TestAnimatedBackground::initTestCase() {
+    QVERIFY(_dir.isValid());
+    _path = _dir.filePath(QStringLiteral("two_frames.gif"));
+    QFile file(_path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(twoFrameGif());
+    file.close();
+
+    if (!AnimatedBackground::isAnimated(_path)) {
+        QSKIP("GIF image format plugin is not available");
+    }
+}
+
+void TestAnimatedBackground::resumesAfterSiblingUncovers() {
+    QWidget window;
+    window.resize(200, 150);
+    auto *target = new QWidget(&window);
+    target->setGeometry(window.rect());
+    auto *cover = new QWidget(&window);
+    cover->setGeometry(window.rect());
+    cover->setAutoFillBackground(true);
+    cover->hide();
+
+    AnimatedBackground anim(target);
+    QString error;
+    QVERIFY2(anim.open(_path, &error), qPrintable(error));
+    anim.setTarget(target->size(), Qt::KeepAspectRatioByExpanding, Mel::ScaleQuality_Nearest);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    anim.start();
+    QTRY_VERIFY(anim.isClockRunning());
+
+    // 兄弟控件完全盖住目标，下一次帧到期时时钟停止
+    cover->show();
+    cover->raise();
+    QTRY_VERIFY_WITH_TIMEOUT(!anim.isClockRunning(), 5000);
+    QVERIFY(anim.isPlaying());
+
+    // 遮挡控件隐藏后目标只收到绘制事件，时钟必须恢复
+    cover->hide();
+    QTRY_VERIFY_WITH_TIMEOUT(anim.isClockRunning(), 5000);
+
+    // 遮挡控件移开同样恢复
+    cover->show();
+    cover->raise();
+    QTRY_VERIFY_WITH_TIMEOUT(!anim.isClockRunning(), 5000);
+    cover->move(window.width(), 0);
+    QTRY_VERIFY_WITH_TIMEOUT(anim.isClockRunning(), 5000);
+}
+
+QTEST_MAIN(TestAnimatedBackground)
+#include "tst_animatedbackground.moc"
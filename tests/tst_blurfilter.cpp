@@ -0,0 +1,142 @@
+/**
+ * @file tst_blurfilter.cpp
+ * @brief BlurFilter 测试 - 每个 SIMD 级别的输出与标量参考实现之间的误差不超过 Tolerance，纯色不变，硬边按半径扩散
+ */
+
+#include "SimdTestUtils.h"
+#include "image/BlurFilter.h"
+#include <QtTest>
+
+using Mel::BlurFilter;
+using Mel::Resampler;
+
+namespace {
+
+/**
+ * @brief 读取像素的红色通道
+ */
+int redAt(const QImage &image, const int x, const int y) {
+    return qRed(reinterpret_cast<const quint32 *>(image.constScanLine(y))[x]);
+}
+
+} // namespace
+
+class TestBlurFilter : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void matchesReference_data();
+    void matchesReference();
+    void constantStaysConstant_data();
+    void constantStaysConstant();
+    void hardEdgeSpreadsByRadius_data();
+    void hardEdgeSpreadsByRadius();
+};
+
+void TestBlurFilter::matchesReference_data() {
+    QTest::addColumn<int>("format");
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<int>("radius");
+
+    // 宽度不是 4 的整数倍时垂直内核会走剩余列的路径；半径超过图片尺寸时边缘延伸覆盖整个窗口
+    const QList<QSize> sizes = {QSize(320, 180), QSize(131, 77)};
+    const QList<int>   radii = {2, 9, 40, 200};
+
+    for (const auto &format : MelTest::testFormats()) {
+        for (const QSize &size : sizes) {
+            for (const int radius : radii) {
+                const QByteArray name = QByteArray(format.first) + '/' + QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height()) + "/r" + QByteArray::number(radius);
+                QTest::newRow(name.constData()) << static_cast<int>(format.second) << size << radius;
+            }
+        }
+    }
+}
+
+void TestBlurFilter::matchesReference() {
+    QFETCH(int, format);
+    QFETCH(QSize, size);
+    QFETCH(int, radius);
+
+    const QImage source    = MelTest::makeImage(size, static_cast<QImage::Format>(format));
+    const QImage reference = BlurFilter::blurReference(source, radius);
+    QCOMPARE(reference.size(), size);
+
+    // 当前 CPU 支持的每个级别，单线程与多线程各一次
+    MelTest::verifyAllSimdLevels(reference, BlurFilter::Tolerance, [&](const Resampler::SimdLevel level, const int threads) {
+        return BlurFilter::blur(source, radius, level, threads);
+    });
+}
+
+void TestBlurFilter::constantStaysConstant_data() {
+    QTest::addColumn<int>("format");
+    QTest::addColumn<uint>("color");
+    QTest::addColumn<int>("radius");
+
+    const QList<int> radii = {2, 9, 40};
+    for (const int radius : radii) {
+        QTest::newRow(qPrintable(QStringLiteral("rgb32/r%1").arg(radius))) << static_cast<int>(QImage::Format_RGB32) << uint(0xFF336699u) << radius;
+        QTest::newRow(qPrintable(QStringLiteral("argb32pm/r%1").arg(radius))) << static_cast<int>(QImage::Format_ARGB32_Premultiplied) << uint(0x80402010u) << radius;
+    }
+}
+
+void TestBlurFilter::constantStaysConstant() {
+    QFETCH(int, format);
+    QFETCH(uint, color);
+    QFETCH(int, radius);
+
+    // 窗口内的平均值仍是原来的颜色，不能因为截断或边缘处理产生偏差
+    QImage source(QSize(131, 77), static_cast<QImage::Format>(format));
+    source.fill(color);
+
+    MelTest::verifyAllSimdLevels(source, 0, [&](const Resampler::SimdLevel level, const int threads) {
+        return BlurFilter::blur(source, radius, level, threads);
+    });
+}
+
+void TestBlurFilter::hardEdgeSpreadsByRadius_data() {
+    QTest::addColumn<bool>("vertical");
+    QTest::addColumn<int>("radius");
+
+    for (const int radius : {4, 12, 30}) {
+        QTest::newRow(qPrintable(QStringLiteral("horizontal/r%1").arg(radius))) << false << radius;
+        QTest::newRow(qPrintable(QStringLiteral("vertical/r%1").arg(radius))) << true << radius;
+    }
+}
+
+void TestBlurFilter::hardEdgeSpreadsByRadius() {
+    QFETCH(bool, vertical);
+    QFETCH(int, radius);
+
+    // 黑白各占一半，边缘在 kEdge 处（水平方向的边缘检查一行，垂直方向检查一列）
+    constexpr int kEdge   = 120;
+    constexpr int kLength = 2 * kEdge;
+    QImage        source(vertical ? QSize(8, kLength) : QSize(kLength, 8), QImage::Format_RGB32);
+    source.fill(Qt::black);
+    for (int i = kEdge; i < kLength; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            source.setPixel(vertical ? j : i, vertical ? i : j, 0xFFFFFFFFu);
+        }
+    }
+
+    const QImage result = BlurFilter::blur(source, radius);
+    auto         valueAt = [&](const int i) { return vertical ? redAt(result, 4, i) : redAt(result, i, 4); };
+
+    // 从黑到白单调过渡
+    for (int i = 1; i < kLength; ++i) {
+        QVERIFY2(valueAt(i) >= valueAt(i - 1), qPrintable(QStringLiteral("not monotonic at %1").arg(i)));
+    }
+
+    // 边缘两侧各约一半亮度，离边缘半个半径（一个标准差）处仍明显被模糊
+    QVERIFY(valueAt(kEdge - 1) > 64 && valueAt(kEdge - 1) < 192);
+    QVERIFY(valueAt(kEdge) > 64 && valueAt(kEdge) < 192);
+    QVERIFY(valueAt(kEdge - radius / 2) > 0);
+    QVERIFY(valueAt(kEdge + radius / 2 - 1) < 255);
+
+    // 三遍盒式模糊的支撑范围约为 1.5 倍半径，两倍半径以外保持原样
+    QCOMPARE(valueAt(kEdge - 2 * radius), 0);
+    QCOMPARE(valueAt(kEdge + 2 * radius - 1), 255);
+}
+
+QTEST_GUILESS_MAIN(TestBlurFilter)
+
+#include "tst_blurfilter.moc"
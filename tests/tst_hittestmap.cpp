@@ -0,0 +1,121 @@
+/**
+ * @file tst_hittestmap.cpp
+ * @brief HitTestMap 测试 - 区域优先级、标题栏上边缘、四个角、客户区和不可调整大小
+ */
+
+#include "widgets/HitTestMap.h"
+#include <QtTest>
+
+using Mel::HitTestArea;
+using Mel::HitTestGeometry;
+using Mel::HitTestMap;
+
+namespace {
+
+constexpr int kWidth  = 800;
+constexpr int kHeight = 600;
+
+/**
+ * @brief 标题栏在顶部，三个按钮贴着右上角，左侧一个客户区控件
+ */
+HitTestGeometry standardGeometry() {
+    HitTestGeometry geometry;
+    geometry.windowSize     = QSize(kWidth, kHeight);
+    geometry.titleBar       = QRect(0, 0, kWidth, 32);
+    geometry.minimizeButton = QRect(kWidth - 138, 0, 46, 32);
+    geometry.maximizeButton = QRect(kWidth - 92, 0, 46, 32);
+    geometry.closeButton    = QRect(kWidth - 46, 0, 46, 32);
+    geometry.clientRegions  = {QRect(40, 4, 200, 24)};
+    return geometry;
+}
+
+} // namespace
+
+class TestHitTestMap : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void buttonsOverBorders();
+    void topEdgeInTitleBar();
+    void corners();
+    void clientRegions();
+    void notResizable();
+};
+
+void TestHitTestMap::buttonsOverBorders() {
+    HitTestMap map;
+    map.build(standardGeometry());
+
+    // 关闭按钮贴着右边框和上边框，按钮优先
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, 0), true), Mel::HitTest_Close);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 2, 16), true), Mel::HitTest_Close);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 70, 1), true), Mel::HitTest_Maximize);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 120, 1), true), Mel::HitTest_Minimize);
+
+    // 按钮下方的右边框照常调整
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, 100), true), Mel::HitTest_Right);
+}
+
+void TestHitTestMap::topEdgeInTitleBar() {
+    HitTestMap map;
+    map.build(standardGeometry());
+
+    QCOMPARE(map.hitTest(QPoint(400, 0), true), Mel::HitTest_Caption);
+    QCOMPARE(map.hitTest(QPoint(400, 3), true), Mel::HitTest_Caption);
+    QCOMPARE(map.hitTest(QPoint(400, 20), true), Mel::HitTest_Caption);
+
+    // 标题栏不在顶部时，上边缘仍然调整大小
+    HitTestGeometry geometry = standardGeometry();
+    geometry.titleBar.moveTop(8);
+    map.build(geometry);
+    QCOMPARE(map.hitTest(QPoint(400, 0), true), Mel::HitTest_Top);
+}
+
+void TestHitTestMap::corners() {
+    HitTestGeometry geometry;
+    geometry.windowSize = QSize(kWidth, kHeight);
+    geometry.titleBar   = QRect(0, 0, kWidth, 32);
+
+    HitTestMap map;
+    map.build(geometry);
+
+    QCOMPARE(map.hitTest(QPoint(0, 0), true), Mel::HitTest_TopLeft);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, 0), true), Mel::HitTest_TopRight);
+    QCOMPARE(map.hitTest(QPoint(0, kHeight - 1), true), Mel::HitTest_BottomLeft);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, kHeight - 1), true), Mel::HitTest_BottomRight);
+
+    QCOMPARE(HitTestMap::toEdges(Mel::HitTest_TopLeft), Qt::Edges(Qt::TopEdge | Qt::LeftEdge));
+    QCOMPARE(HitTestMap::toEdges(Mel::HitTest_BottomRight), Qt::Edges(Qt::BottomEdge | Qt::RightEdge));
+    QCOMPARE(HitTestMap::toEdges(Mel::HitTest_Caption), Qt::Edges());
+}
+
+void TestHitTestMap::clientRegions() {
+    HitTestMap map;
+    map.build(standardGeometry());
+
+    QCOMPARE(map.hitTest(QPoint(40, 4), true), Mel::HitTest_Client);
+    QCOMPARE(map.hitTest(QPoint(239, 27), true), Mel::HitTest_Client);
+
+    // 客户区上下方和右侧仍是标题栏
+    QCOMPARE(map.hitTest(QPoint(100, 29), true), Mel::HitTest_Caption);
+    QCOMPARE(map.hitTest(QPoint(240, 16), true), Mel::HitTest_Caption);
+
+    // 标题栏以外是客户区
+    QCOMPARE(map.hitTest(QPoint(400, 300), true), Mel::HitTest_Client);
+}
+
+void TestHitTestMap::notResizable() {
+    HitTestMap map;
+    map.build(standardGeometry());
+
+    QCOMPARE(map.hitTest(QPoint(0, 300), false), Mel::HitTest_Client);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, 300), false), Mel::HitTest_Client);
+    QCOMPARE(map.hitTest(QPoint(400, kHeight - 1), false), Mel::HitTest_Client);
+    QCOMPARE(map.hitTest(QPoint(0, 0), false), Mel::HitTest_Caption);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, kHeight - 1), false), Mel::HitTest_Client);
+    QCOMPARE(map.hitTest(QPoint(kWidth - 1, 0), false), Mel::HitTest_Close);
+}
+
+QTEST_GUILESS_MAIN(TestHitTestMap)
+
+#include "tst_hittestmap.moc"
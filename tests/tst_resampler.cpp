@@ -0,0 +1,70 @@
+/**
+ * @file tst_resampler.cpp
+ * @brief Resampler 测试 - 每个 SIMD 级别的输出与标量参考实现之间的误差不超过 Tolerance
+ */
+
+#include "SimdTestUtils.h"
+#include "image/Resampler.h"
+#include <QtTest>
+
+using Mel::Resampler;
+using Mel::ScaleQuality;
+
+Q_DECLARE_METATYPE(Mel::ScaleQuality)
+
+class TestResampler : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void matchesReference_data();
+    void matchesReference();
+};
+
+void TestResampler::matchesReference_data() {
+    QTest::addColumn<int>("format");
+    QTest::addColumn<QSize>("sourceSize");
+    QTest::addColumn<QSize>("targetSize");
+    QTest::addColumn<ScaleQuality>("quality");
+
+    // 缩小、放大、只有一个方向变化，以及不是 SIMD 宽度整数倍的宽度
+    const QList<QPair<QSize, QSize>> sizes = {
+            {QSize(640, 360), QSize(213, 119)},
+            {QSize(97, 61), QSize(301, 187)},
+            {QSize(300, 200), QSize(123, 200)},
+            {QSize(300, 200), QSize(300, 77)},
+    };
+    const QList<QPair<const char *, ScaleQuality>> qualities = {
+            {"nearest", Mel::ScaleQuality_Nearest},
+            {"bilinear", Mel::ScaleQuality_Bilinear},
+            {"area", Mel::ScaleQuality_Area},
+            {"lanczos3", Mel::ScaleQuality_Lanczos3},
+    };
+    for (const auto &format : MelTest::testFormats()) {
+        for (const auto &quality : qualities) {
+            for (const auto &size : sizes) {
+                const QByteArray name = QByteArray(format.first) + '/' + quality.first + '/' + QByteArray::number(size.first.width()) + 'x' + QByteArray::number(size.first.height()) + "->" + QByteArray::number(size.second.width()) + 'x' + QByteArray::number(size.second.height());
+                QTest::newRow(name.constData()) << static_cast<int>(format.second) << size.first << size.second << quality.second;
+            }
+        }
+    }
+}
+
+void TestResampler::matchesReference() {
+    QFETCH(int, format);
+    QFETCH(QSize, sourceSize);
+    QFETCH(QSize, targetSize);
+    QFETCH(ScaleQuality, quality);
+
+    const QImage source    = MelTest::makeImage(sourceSize, static_cast<QImage::Format>(format));
+    const QImage reference = Resampler::scaleReference(source, targetSize, quality);
+    QCOMPARE(reference.size(), targetSize);
+
+    // 当前 CPU 支持的每个级别，单线程与多线程各一次
+    MelTest::verifyAllSimdLevels(reference, Resampler::Tolerance, [&](const Resampler::SimdLevel level, const int threads) {
+        return Resampler::scale(source, targetSize, quality, level, threads);
+    });
+}
+
+QTEST_GUILESS_MAIN(TestResampler)
+
+#include "tst_resampler.moc"
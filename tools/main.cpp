@@ -0,0 +1,94 @@
+/**
+ * @file main.cpp
+ * @brief 像素容器转换工具 - 构建时把壁纸转换为可直接映射的 .melpix 容器
+ *
+ * 用法：Mel_transcode [--level 1920x1080] [--level 2560x1440] [--preview 32] 输入图片 输出容器
+ *
+ * 第 0 级为完整原图，每个 --level 生成一级预先缩小的版本（按比例覆盖该尺寸，不放大），
+ * 运行时按显示尺寸解码可以直接选用对应的级别。--preview 在最后追加一级极小的预览
+ * （最长边像素，不超过 ImagePreview::MaxSize），渐进加载时在解码完成之前先显示
+ */
+
+#include "image/PixelContainer.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <algorithm>
+#include <cstdio>
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Mel_transcode");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("把图片转换为 Mel 像素容器（.melpix）");
+    parser.addHelpOption();
+    const QCommandLineOption levelOption("level", "预先缩小的级别（宽x高），可重复", "size");
+    parser.addOption(levelOption);
+    const QCommandLineOption previewOption("preview", "追加的预览级别（最长边像素，0 表示不生成）", "size", "0");
+    parser.addOption(previewOption);
+    parser.addPositionalArgument("input", "输入图片");
+    parser.addPositionalArgument("output", "输出容器文件");
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+    const QString input  = arguments[0];
+    const QString output = arguments[1];
+
+    QImageReader reader(input);
+    reader.setAutoTransform(true);
+    const QImage source = reader.read();
+    if (source.isNull()) {
+        std::fprintf(stderr, "无法读取 %s: %s\n", qPrintable(input), qPrintable(reader.errorString()));
+        return 1;
+    }
+
+    // 与运行时解码结果相同的格式
+    const QImage::Format format = source.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+    QVector<QImage>      levels{source.convertToFormat(format)};
+
+    // 从大到小生成各级，跳过不小于原图的级别
+    QList<QSize> bounds;
+    for (const QString &value : parser.values(levelOption)) {
+        const QStringList parts = value.toLower().split('x');
+        const QSize       size  = parts.size() == 2 ? QSize(parts[0].toInt(), parts[1].toInt()) : QSize();
+        if (size.isEmpty()) {
+            std::fprintf(stderr, "无效的级别: %s\n", qPrintable(value));
+            return 1;
+        }
+        bounds.append(size);
+    }
+    std::sort(bounds.begin(), bounds.end(), [](const QSize &a, const QSize &b) { return a.width() * a.height() > b.width() * b.height(); });
+
+    for (const QSize &bound : bounds) {
+        const QSize size = source.size().scaled(bound, Qt::KeepAspectRatioByExpanding);
+        if (size.width() >= source.width() || size.height() >= source.height() || size == levels.last().size()) {
+            continue;
+        }
+        levels.append(levels.first().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation).convertToFormat(format));
+    }
+
+    // 预览从最小的一级缩小即可
+    const int previewSize = parser.value(previewOption).toInt();
+    if (previewSize > 0) {
+        const QSize size = source.size().scaled(QSize(previewSize, previewSize), Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+        if (size.width() < levels.last().width() && size.height() < levels.last().height()) {
+            levels.append(levels.last().scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation).convertToFormat(format));
+        }
+    }
+
+    QDir().mkpath(QFileInfo(output).absolutePath());
+    QString errorString;
+    if (!Mel::PixelContainer::write(output, levels, source.size(), &errorString)) {
+        std::fprintf(stderr, "无法写入 %s: %s\n", qPrintable(output), qPrintable(errorString));
+        return 1;
+    }
+
+    std::printf("%s -> %s (%d 级)\n", qPrintable(input), qPrintable(output), static_cast<int>(levels.size()));
+    return 0;
+}